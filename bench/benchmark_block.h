@@ -0,0 +1,130 @@
+#pragma once
+
+#include <timeplus/client.h>
+
+namespace timeplus {
+
+/* Block written by the benchmarks, 32 columns of the stream below.
+
+CREATE STREAM IF NOT EXISTS insert_benchmark_test (
+  Field1 string,
+  Field2 string,
+  Field3 int64,
+  Field4 int64,
+  Field5 string,
+  Field6 low_cardinality(string),
+  Field7 low_cardinality(string),
+  Field8 string,
+  Field9 low_cardinality(string),
+  Field10 string,
+  Field11 low_cardinality(string),
+  Field12 low_cardinality(string),
+  Field13 string,
+  Field14 string,
+  Field15 string,
+  Field16 int64,
+  Field17 int64,
+  Field18 int64,
+  Field19 int64,
+  Field20 int32,
+  Field21 float64,
+  Field22 float64,
+  Field23 float64,
+  Field24 string,
+  Field25 int64,
+  Field26 int64,
+  Field27 float64,
+  Field28 float64,
+  Field29 float64,
+  Field30 string,
+  Field31 string,
+  Field32 string,
+  _tp_time datetime64(3,'UTC') DEFAULT now64(3,'UTC') CODEC(DoubleDelta, LZ4),
+  INDEX _tp_time_index _tp_time TYPE minmax GRANULARITY 2
+)
+
+*/
+
+using InsertBlock = TypedBlock<
+    ColumnString,
+    ColumnString,
+    ColumnInt64,
+    ColumnInt64,
+    ColumnString,
+    ColumnLowCardinalityT<ColumnString>,
+    ColumnLowCardinalityT<ColumnString>,
+    ColumnString,
+    ColumnLowCardinalityT<ColumnString>,
+    ColumnString,
+    ColumnLowCardinalityT<ColumnString>,
+    ColumnLowCardinalityT<ColumnString>,
+    ColumnString,
+    ColumnString,
+    ColumnString,
+    ColumnInt64,
+    ColumnInt64,
+    ColumnInt64,
+    ColumnInt64,
+    ColumnInt32,
+    ColumnFloat64,
+    ColumnFloat64,
+    ColumnFloat64,
+    ColumnString,
+    ColumnInt64,
+    ColumnInt64,
+    ColumnFloat64,
+    ColumnFloat64,
+    ColumnFloat64,
+    ColumnString,
+    ColumnString,
+    ColumnString>;
+
+/// Block of `rows` identical rows for the insert_benchmark_test stream above.
+inline BlockPtr createBlock(size_t rows) {
+    InsertBlock block({
+        "Field1", "Field2", "Field3", "Field4", "Field5", "Field6", "Field7", "Field8",
+        "Field9", "Field10", "Field11", "Field12", "Field13", "Field14", "Field15", "Field16",
+        "Field17", "Field18", "Field19", "Field20", "Field21", "Field22", "Field23", "Field24",
+        "Field25", "Field26", "Field27", "Field28", "Field29", "Field30", "Field31", "Field32"});
+
+    block.Reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        block.AppendRow(
+            "123456",
+            "142400000",
+            20230328,
+            142400000,
+            "123",
+            "DefaultField6",
+            "02001",
+            "600001",
+            "DefaultField9",
+            "600001.SH",
+            "TestLevel",
+            "DefaultField12",
+            "3",
+            "Test_Data",
+            "TransactionType",
+            12,
+            1243,
+            25467,
+            1,
+            1,
+            10.56,
+            100,
+            234.67,
+            "ABCD1111",
+            20230403123400000,
+            10,
+            12.03,
+            1.5,
+            123.0,
+            "20230328",
+            "175638123",
+            "80-12345353-213-12345");
+    }
+
+    return std::make_shared<Block>(block.ToBlock());
+}
+
+}
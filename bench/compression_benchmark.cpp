@@ -0,0 +1,107 @@
+#include <timeplus/client.h>
+#include <timeplus/base/compressed.h>
+#include <timeplus/base/input.h>
+#include <timeplus/base/output.h>
+
+#include "benchmark_block.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace timeplus;
+
+/* Measures compression ratio and throughput of the native block payload
+ * on the same 32-column block as the insert benchmarks, no server required.
+ */
+
+Buffer serializeBlock(const Block& block) {
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
+        bi.Column()->Save(&output);
+    }
+    output.Flush();
+    return buffer;
+}
+
+struct Method {
+    const char* name;
+    CompressionMethod method;
+    int level;
+};
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <batch_size>" << std::endl;
+        return 1;
+    }
+
+    const auto batch_size = std::stoul(argv[1]);
+    constexpr int repeat_times = 20;
+
+    auto block = createBlock(batch_size);
+    const auto payload = serializeBlock(*block);
+
+    const Method methods[] = {
+        {"LZ4", CompressionMethod::LZ4, 0},
+        {"ZSTD(1)", CompressionMethod::ZSTD, 1},
+        {"ZSTD(3)", CompressionMethod::ZSTD, 3},
+        {"ZSTD(6)", CompressionMethod::ZSTD, 6},
+    };
+    const size_t chunk_sizes[] = {65535, 1024 * 1024};
+
+    std::cout << "rows: " << block->GetRowCount() << ", raw bytes: " << payload.size() << std::endl;
+    std::cout << "method,chunk_size,compressed_bytes,ratio,compress_MBps,decompress_MBps" << std::endl;
+
+    for (const auto& m : methods) {
+        for (const auto chunk_size : chunk_sizes) {
+            Buffer compressed;
+            std::chrono::duration<double> compress_time{0};
+            for (int i = 0; i < repeat_times; ++i) {
+                compressed.clear();
+                BufferOutput destination(&compressed);
+
+                auto start = std::chrono::high_resolution_clock::now();
+                {
+                    CompressedOutput output(&destination, chunk_size, m.method, m.level);
+                    output.Write(payload.data(), payload.size());
+                    output.Flush();
+                }
+                compress_time += std::chrono::high_resolution_clock::now() - start;
+            }
+
+            Buffer decompressed(payload.size());
+            std::chrono::duration<double> decompress_time{0};
+            for (int i = 0; i < repeat_times; ++i) {
+                ArrayInput source(compressed.data(), compressed.size());
+
+                auto start = std::chrono::high_resolution_clock::now();
+                {
+                    CompressedInput input(&source);
+                    size_t read = 0;
+                    while (read < decompressed.size()) {
+                        const size_t bytes = input.Read(decompressed.data() + read, decompressed.size() - read);
+                        if (bytes == 0) {
+                            std::cerr << m.name << ": compressed data ends after " << read << " of "
+                                      << decompressed.size() << " bytes" << std::endl;
+                            return 1;
+                        }
+                        read += bytes;
+                    }
+                }
+                decompress_time += std::chrono::high_resolution_clock::now() - start;
+            }
+
+            const double mb = payload.size() * repeat_times / (1024.0 * 1024.0);
+            std::cout << m.name << "," << chunk_size << "," << compressed.size() << ","
+                      << std::fixed << std::setprecision(2)
+                      << static_cast<double>(payload.size()) / compressed.size() << ","
+                      << mb / compress_time.count() << ","
+                      << mb / decompress_time.count() << std::endl;
+            std::cout.unsetf(std::ios_base::floatfield);
+        }
+    }
+
+    return 0;
+}
@@ -27,6 +27,14 @@ constexpr size_t DBMS_MAX_COMPRESSED_SIZE = 0x40000000ULL;   // 1GB
 
 namespace timeplus {
 
+void CompressedInput::ZstdDCtxDeleter::operator()(ZSTD_DCtx* ctx) const {
+    ZSTD_freeDCtx(ctx);
+}
+
+void CompressedOutput::ZstdCCtxDeleter::operator()(ZSTD_CCtx* ctx) const {
+    ZSTD_freeCCtx(ctx);
+}
+
 CompressedInput::CompressedInput(InputStream* input)
     : input_(input)
 {
@@ -54,6 +62,17 @@ size_t CompressedInput::DoNext(const void** ptr, size_t len) {
     return mem_.Next(ptr, len);
 }
 
+size_t CompressedInput::DoPeek(const void** ptr) {
+    if (mem_.Exhausted()) {
+        if (!Decompress()) {
+            *ptr = nullptr;
+            return 0;
+        }
+    }
+
+    return mem_.Peek(ptr);
+}
+
 bool CompressedInput::Decompress() {
     uint128 hash;
     uint32_t compressed = 0;
@@ -114,7 +133,13 @@ bool CompressedInput::Decompress() {
     }
 
     case static_cast<uint8_t>(CompressionMethodByte::ZSTD): {
-        size_t res = ZSTD_decompress((char*)data_.data(), original, (const char*)tmp.data() + HEADER_SIZE, static_cast<int>(compressed - HEADER_SIZE));
+        if (!zstd_context_) {
+            zstd_context_.reset(ZSTD_createDCtx());
+            if (!zstd_context_)
+                throw CompressionError("can't create ZSTD decompression context");
+        }
+
+        size_t res = ZSTD_decompressDCtx(zstd_context_.get(), (char*)data_.data(), original, (const char*)tmp.data() + HEADER_SIZE, static_cast<int>(compressed - HEADER_SIZE));
 
         if (ZSTD_isError(res)) {
             throw CompressionError("can't decompress ZSTD-encoded data, ZSTD error: " + std::string(ZSTD_getErrorName(res)));
@@ -136,10 +161,11 @@ bool CompressedInput::Decompress() {
 }
 
 
-CompressedOutput::CompressedOutput(OutputStream * destination, size_t max_compressed_chunk_size, CompressionMethod method)
+CompressedOutput::CompressedOutput(OutputStream * destination, size_t max_compressed_chunk_size, CompressionMethod method, int zstd_compression_level)
     : destination_(destination)
     , max_compressed_chunk_size_(max_compressed_chunk_size)
     , method_(method)
+    , zstd_compression_level_(zstd_compression_level)
 {
     PreallocateCompressBuffer(max_compressed_chunk_size);
 }
@@ -196,12 +222,19 @@ void CompressedOutput::Compress(const void * data, size_t len) {
     }
 
     case timeplus::CompressionMethod::ZSTD: {
-        const size_t compressed_size = ZSTD_compress(
+        if (!zstd_context_) {
+            zstd_context_.reset(ZSTD_createCCtx());
+            if (!zstd_context_)
+                throw CompressionError("Failed to create ZSTD compression context");
+        }
+
+        const size_t compressed_size = ZSTD_compressCCtx(
+                zstd_context_.get(),
                 (char*)compressed_buffer_.data() + HEADER_SIZE,
                 static_cast<int>(compressed_buffer_.size() - HEADER_SIZE),
                 (const char*)data,
                 static_cast<int>(len),
-                ZSTD_fast);
+                zstd_compression_level_);
         if (ZSTD_isError(compressed_size))
             throw CompressionError("Failed to compress chunk of " + std::to_string(len) + " bytes, "
                     "ZSTD error: " + std::string(ZSTD_getErrorName(compressed_size)));
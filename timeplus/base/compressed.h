@@ -6,6 +6,11 @@
 
 #include "timeplus/client.h"
 
+#include <memory>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
 namespace timeplus {
 
 class CompressedInput : public ZeroCopyInput {
@@ -15,21 +20,31 @@ public:
 
 protected:
     size_t DoNext(const void** ptr, size_t len) override;
+    size_t DoPeek(const void** ptr) override;
 
     bool Decompress();
 
 private:
+    struct ZstdDCtxDeleter {
+        void operator()(ZSTD_DCtx_s* ctx) const;
+    };
+
     InputStream* const input_;
 
     Buffer data_;
     ArrayInput mem_;
+    /// Reused across ZSTD chunks to avoid allocating a decompression context per chunk.
+    std::unique_ptr<ZSTD_DCtx_s, ZstdDCtxDeleter> zstd_context_;
 };
 
 class CompressedOutput : public OutputStream {
 public:
-    explicit CompressedOutput(OutputStream* destination, size_t max_compressed_chunk_size = 0, CompressionMethod method = CompressionMethod::LZ4);
+    explicit CompressedOutput(OutputStream* destination, size_t max_compressed_chunk_size = 0, CompressionMethod method = CompressionMethod::LZ4,
+                              int zstd_compression_level = DEFAULT_ZSTD_COMPRESSION_LEVEL);
     ~CompressedOutput() override;
 
+    static constexpr int DEFAULT_ZSTD_COMPRESSION_LEVEL = timeplus::DEFAULT_ZSTD_COMPRESSION_LEVEL;
+
 protected:
     size_t DoWrite(const void* data, size_t len) override;
     void DoFlush() override;
@@ -39,10 +54,17 @@ private:
     void PreallocateCompressBuffer(size_t input_size);
 
 private:
+    struct ZstdCCtxDeleter {
+        void operator()(ZSTD_CCtx_s* ctx) const;
+    };
+
     OutputStream * destination_;
     const size_t max_compressed_chunk_size_;
     Buffer compressed_buffer_;
     CompressionMethod method_;
+    const int zstd_compression_level_;
+    /// Reused across ZSTD chunks, each chunk is still a self-contained frame which the server decodes independently.
+    std::unique_ptr<ZSTD_CCtx_s, ZstdCCtxDeleter> zstd_context_;
 };
 
 }
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#elif defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace timeplus {
+
+/** Open-addressing hash map with linear probing, keeping all items in a single flat array.
+ *
+ *  Each slot has a control byte: either EMPTY or 7 low bits of the item hash.
+ *  Lookup checks 16 control bytes at once (with SSE2 where available) and compares
+ *  keys only for slots with matching bits, so a miss rarely touches the items themselves.
+ *  Erase does backward-shift deletion, so there are no tombstones and lookups stay short.
+ *
+ *  Hash must be well mixed in all bits, since both low (control byte) and high (position) bits are used.
+ *  Iterators (plain pointers to items) are invalidated by any insertion or erase.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    FlatHashMap() = default;
+
+    /// Number of items in the map.
+    inline size_t size() const noexcept { return size_; }
+    inline bool empty() const noexcept { return size_ == 0; }
+    /// Number of slots, at most 7/8 of them can be used before the map grows.
+    inline size_t capacity() const noexcept { return slots_.size(); }
+    /// Memory held by the map, in bytes.
+    inline size_t allocated_bytes() const noexcept { return ctrl_.capacity() + slots_.capacity() * sizeof(value_type); }
+
+    /// Makes room for at least `count` items without rehashing.
+    void reserve(size_t count) {
+        size_t new_capacity = GROUP_SIZE;
+        while (MaxLoad(new_capacity) < count) {
+            new_capacity *= 2;
+        }
+
+        if (new_capacity > capacity()) {
+            Rehash(new_capacity);
+        }
+    }
+
+    /// Removes all items, keeping allocated memory.
+    void clear() noexcept {
+        std::fill(ctrl_.begin(), ctrl_.end(), EMPTY);
+        size_ = 0;
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        ctrl_.swap(other.ctrl_);
+        slots_.swap(other.slots_);
+        std::swap(size_, other.size_);
+    }
+
+    /// Returns pointer to the item with given key or nullptr.
+    iterator find(const Key& key) {
+        return const_cast<iterator>(static_cast<const FlatHashMap&>(*this).find(key));
+    }
+
+    const_iterator find(const Key& key) const {
+        if (size_ == 0) {
+            return nullptr;
+        }
+
+        const auto [slot, found] = Lookup(key, Hash{}(key));
+        return found ? &slots_[slot] : nullptr;
+    }
+
+    /// Inserts {key, value} if there is no item with such key yet, returns item with that key and whether it was inserted.
+    std::pair<iterator, bool> try_emplace(const Key& key, const Value& value) {
+        if (size_ + 1 > MaxLoad(capacity())) {
+            Rehash(capacity() ? capacity() * 2 : GROUP_SIZE);
+        }
+
+        const size_t hash = Hash{}(key);
+        const auto [slot, found] = Lookup(key, hash);
+        if (found) {
+            return {&slots_[slot], false};
+        }
+
+        SetCtrl(slot, Tag(hash));
+        slots_[slot] = value_type{key, value};
+        ++size_;
+
+        return {&slots_[slot], true};
+    }
+
+    inline std::pair<iterator, bool> emplace(const Key& key, const Value& value) {
+        return try_emplace(key, value);
+    }
+
+    /// Removes the item, which must belong to this map.
+    void erase(const_iterator item) {
+        const size_t mask = capacity() - 1;
+        size_t hole = static_cast<size_t>(item - slots_.data());
+
+        // Move back items that were placed past the hole because of collisions, until the end of the run.
+        for (size_t pos = (hole + 1) & mask; ctrl_[pos] != EMPTY; pos = (pos + 1) & mask) {
+            const size_t home = Position(Hash{}(slots_[pos].first));
+            if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+                slots_[hole] = std::move(slots_[pos]);
+                SetCtrl(hole, ctrl_[pos]);
+                hole = pos;
+            }
+        }
+
+        SetCtrl(hole, EMPTY);
+        --size_;
+    }
+
+private:
+    static constexpr size_t GROUP_SIZE = 16;
+    static constexpr uint8_t EMPTY = 0x80;
+
+    static inline size_t MaxLoad(size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    static inline uint8_t Tag(size_t hash) noexcept {
+        return static_cast<uint8_t>(hash & 0x7F);
+    }
+
+    inline size_t Position(size_t hash) const noexcept {
+        return (hash >> 7) & (capacity() - 1);
+    }
+
+    static inline uint32_t CountTrailingZeros(uint32_t value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long result;
+        _BitScanForward(&result, value);
+        return static_cast<uint32_t>(result);
+#else
+        return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+    }
+
+    /// Bit i is set if i-th control byte of the group equals `value`.
+    static inline uint32_t MatchGroup(const uint8_t* group, uint8_t value) noexcept {
+#if defined(__SSE2__)
+        const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+        uint32_t result = 0;
+        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+            result |= uint32_t(group[i] == value) << i;
+        }
+        return result;
+#endif
+    }
+
+    /// Returns slot of the item with given key and true, or the slot where such item should be inserted and false.
+    std::pair<size_t, bool> Lookup(const Key& key, size_t hash) const {
+        const size_t mask = capacity() - 1;
+        const uint8_t tag = Tag(hash);
+
+        for (size_t pos = Position(hash); ; pos = (pos + GROUP_SIZE) & mask) {
+            const uint8_t* group = &ctrl_[pos];
+            const uint32_t empty = MatchGroup(group, EMPTY);
+            uint32_t candidates = MatchGroup(group, tag);
+
+            // Probe sequence ends at the first empty slot, items past it belong to other sequences.
+            if (empty) {
+                candidates &= (empty & (~empty + 1)) - 1;
+            }
+
+            while (candidates) {
+                const size_t slot = (pos + CountTrailingZeros(candidates)) & mask;
+                if (KeyEqual{}(slots_[slot].first, key)) {
+                    return {slot, true};
+                }
+                candidates &= candidates - 1;
+            }
+
+            if (empty) {
+                return {(pos + CountTrailingZeros(empty)) & mask, false};
+            }
+        }
+    }
+
+    /// Control bytes of the first group are mirrored past the end, so any group can be loaded without wrapping around.
+    inline void SetCtrl(size_t slot, uint8_t value) noexcept {
+        ctrl_[slot] = value;
+        if (slot < GROUP_SIZE) {
+            ctrl_[capacity() + slot] = value;
+        }
+    }
+
+    void Rehash(size_t new_capacity) {
+        std::vector<uint8_t> old_ctrl(new_capacity + GROUP_SIZE, EMPTY);
+        std::vector<value_type> old_slots(new_capacity);
+        old_ctrl.swap(ctrl_);
+        old_slots.swap(slots_);
+
+        for (size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_ctrl[i] == EMPTY) {
+                continue;
+            }
+
+            const size_t hash = Hash{}(old_slots[i].first);
+            const size_t slot = Lookup(old_slots[i].first, hash).first;
+            SetCtrl(slot, Tag(hash));
+            slots_[slot] = std::move(old_slots[i]);
+        }
+    }
+
+private:
+    std::vector<uint8_t> ctrl_;
+    std::vector<value_type> slots_;
+    size_t size_ = 0;
+};
+
+}
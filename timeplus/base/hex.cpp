@@ -0,0 +1,104 @@
+#include "hex.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace timeplus {
+
+namespace {
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+inline int DecodeHexDigit(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+#if defined(__SSE2__)
+
+/// Hex digits to their values, sets bytes of `invalid` where there is no hex digit.
+/// Comparisons are signed, so characters above 0x7F fall out of both ranges.
+inline __m128i HexToNibbles(__m128i chars, __m128i & invalid) {
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_and_si128(
+        _mm_cmpgt_epi8(digits, _mm_set1_epi8(-1)), _mm_cmplt_epi8(digits, _mm_set1_epi8(10)));
+
+    // Lower case, digits are not affected by that.
+    const __m128i letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter = _mm_and_si128(
+        _mm_cmpgt_epi8(letters, _mm_set1_epi8(-1)), _mm_cmplt_epi8(letters, _mm_set1_epi8(6)));
+
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digits),
+        _mm_and_si128(is_letter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+}
+
+/// Combines pairs of nibbles (high one first) into bytes, in low halves of 16-bit lanes.
+inline __m128i CombineNibbles(__m128i nibbles) {
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4);
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(high, low);
+}
+
+inline __m128i NibblesToHex(__m128i nibbles) {
+    const __m128i letters_offset = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters_offset);
+}
+
+#endif
+
+}
+
+bool DecodeHex(const char* hex, size_t size, uint8_t* output) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128i invalid = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        const __m128i first = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i * 2)), invalid);
+        const __m128i second = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i * 2 + 16)), invalid);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(CombineNibbles(first), CombineNibbles(second)));
+    }
+    if (_mm_movemask_epi8(invalid) != 0)
+        return false;
+#endif
+
+    for (; i < size; ++i) {
+        const int high = DecodeHexDigit(hex[i * 2]);
+        const int low = DecodeHexDigit(hex[i * 2 + 1]);
+        if (high < 0 || low < 0)
+            return false;
+        output[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+
+    return true;
+}
+
+void EncodeHex(const uint8_t* data, size_t size, char* output) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        const __m128i low = _mm_and_si128(bytes, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), NibblesToHex(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2 + 16), NibblesToHex(_mm_unpackhi_epi8(high, low)));
+    }
+#endif
+
+    for (; i < size; ++i) {
+        output[i * 2] = HEX_DIGITS[data[i] >> 4];
+        output[i * 2 + 1] = HEX_DIGITS[data[i] & 0x0f];
+    }
+}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace timeplus {
+
+/// Decodes `size` bytes from 2 * `size` hex digits (either case) into `output`.
+/// Returns false if there is any other character, `output` is partially written then.
+bool DecodeHex(const char* hex, size_t size, uint8_t* output);
+
+/// Encodes `size` bytes into 2 * `size` lowercase hex digits.
+void EncodeHex(const uint8_t* data, size_t size, char* output);
+
+}
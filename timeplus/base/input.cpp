@@ -20,6 +20,11 @@ bool ZeroCopyInput::Skip(size_t bytes) {
     return true;
 }
 
+size_t ZeroCopyInput::DoPeek(const void** ptr) {
+    *ptr = nullptr;
+    return 0;
+}
+
 size_t ZeroCopyInput::DoRead(void* buf, size_t len) {
     const void* ptr;
     size_t result = DoNext(&ptr, len);
@@ -55,10 +60,14 @@ size_t ArrayInput::DoNext(const void** ptr, size_t len) {
     return len;
 }
 
+size_t ArrayInput::DoPeek(const void** ptr) {
+    *ptr = data_;
+    return len_;
+}
+
 
 BufferedInput::BufferedInput(std::unique_ptr<InputStream> source, size_t buflen)
     : source_(std::move(source))
-    , array_input_(nullptr, 0)
     , buffer_(buflen)
 {
 }
@@ -66,31 +75,58 @@ BufferedInput::BufferedInput(std::unique_ptr<InputStream> source, size_t buflen)
 BufferedInput::~BufferedInput() = default;
 
 void BufferedInput::Reset() {
-    array_input_.Reset(nullptr, 0);
+    buffer_pos_ = nullptr;
+    buffer_end_ = nullptr;
+}
+
+size_t BufferedInput::Refill() {
+    const size_t len = source_->Read(buffer_.data(), buffer_.size());
+
+    buffer_pos_ = buffer_.data();
+    buffer_end_ = buffer_pos_ + len;
+
+    return len;
 }
 
 size_t BufferedInput::DoNext(const void** ptr, size_t len)  {
-    if (array_input_.Exhausted()) {
-        array_input_.Reset(
-            buffer_.data(), source_->Read(buffer_.data(), buffer_.size())
-        );
+    if (buffer_pos_ == buffer_end_) {
+        Refill();
+    }
+
+    len = std::min(len, static_cast<size_t>(buffer_end_ - buffer_pos_));
+
+    *ptr = buffer_pos_;
+    buffer_pos_ += len;
+
+    return len;
+}
+
+size_t BufferedInput::DoPeek(const void** ptr) {
+    if (buffer_pos_ == buffer_end_) {
+        Refill();
     }
 
-    return array_input_.Next(ptr, len);
+    *ptr = buffer_pos_;
+    return buffer_end_ - buffer_pos_;
 }
 
 size_t BufferedInput::DoRead(void* buf, size_t len) {
-    if (array_input_.Exhausted()) {
+    if (buffer_pos_ == buffer_end_) {
         if (len > buffer_.size() / 2) {
             return source_->Read(buf, len);
         }
 
-        array_input_.Reset(
-            buffer_.data(), source_->Read(buffer_.data(), buffer_.size())
-        );
+        Refill();
     }
 
-    return array_input_.Read(buf, len);
+    len = std::min(len, static_cast<size_t>(buffer_end_ - buffer_pos_));
+
+    if (len) {
+        memcpy(buf, buffer_pos_, len);
+        buffer_pos_ += len;
+    }
+
+    return len;
 }
 
 }
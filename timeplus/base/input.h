@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include <memory>
 
@@ -14,11 +15,24 @@ public:
 
     /// Reads one byte from the stream.
     inline bool ReadByte(uint8_t* byte) {
+        if (buffer_pos_ != buffer_end_) {
+            *byte = *buffer_pos_++;
+            return true;
+        }
         return DoRead(byte, sizeof(uint8_t)) == sizeof(uint8_t);
     }
 
     /// Reads some data from the stream.
     inline size_t Read(void* buf, size_t len) {
+        // Unbuffered streams have null buffer pointers, which memcpy must not get even for 0 bytes.
+        if (len == 0) {
+            return 0;
+        }
+        if (static_cast<size_t>(buffer_end_ - buffer_pos_) >= len) {
+            memcpy(buf, buffer_pos_, len);
+            buffer_pos_ += len;
+            return len;
+        }
         return DoRead(buf, len);
     }
 
@@ -27,6 +41,15 @@ public:
 
 protected:
     virtual size_t DoRead(void* buf, size_t len) = 0;
+
+protected:
+    /** Unread bytes a buffering stream has at hand.
+     *
+     *  ReadByte() and Read() consume them inline, going to DoRead() only
+     *  when the request can't be served from this range.
+     */
+    const uint8_t* buffer_pos_ = nullptr;
+    const uint8_t* buffer_end_ = nullptr;
 };
 
 
@@ -36,11 +59,19 @@ public:
         return DoNext(buf, len);
     }
 
+    /// Returns contiguous unread bytes without consuming them, 0 if there is no more data.
+    inline size_t Peek(const void** buf) {
+        return DoPeek(buf);
+    }
+
     bool Skip(size_t bytes) override;
 
 protected:
     virtual size_t DoNext(const void** ptr, size_t len) = 0;
 
+    /// Default implementation exposes nothing, so callers fall back to Read()/Next().
+    virtual size_t DoPeek(const void** ptr);
+
     size_t DoRead(void* buf, size_t len) override;
 };
 
@@ -76,6 +107,7 @@ public:
 
 private:
     size_t DoNext(const void** ptr, size_t len) override;
+    size_t DoPeek(const void** ptr) override;
 
 private:
     const uint8_t* data_;
@@ -83,6 +115,12 @@ private:
 };
 
 
+/**
+ * Reads data from the source in chunks of `buflen` bytes.
+ *
+ * Buffered bytes are exposed via InputStream::buffer_pos_/buffer_end_,
+ * so small reads (e.g. by WireFormat) don't go through virtual calls.
+ */
 class BufferedInput : public ZeroCopyInput {
 public:
     BufferedInput(std::unique_ptr<InputStream> source, size_t buflen = 8192);
@@ -93,10 +131,14 @@ public:
 protected:
     size_t DoRead(void* buf, size_t len) override;
     size_t DoNext(const void** ptr, size_t len) override;
+    size_t DoPeek(const void** ptr) override;
+
+private:
+    /// Reads next chunk from the source into the buffer, returns number of bytes read.
+    size_t Refill();
 
 private:
     std::unique_ptr<InputStream> const source_;
-    ArrayInput array_input_;
     std::vector<uint8_t> buffer_;
 };
 
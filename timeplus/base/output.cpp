@@ -69,36 +69,41 @@ size_t BufferOutput::DoNext(void** data, size_t len) {
 BufferedOutput::BufferedOutput(std::unique_ptr<OutputStream> destination, size_t buflen)
     : destination_(std::move(destination))
     , buffer_(buflen)
-    , array_output_(buffer_.data(), buflen)
 {
+    Reset();
 }
 
 BufferedOutput::~BufferedOutput() { }
 
 void BufferedOutput::Reset() {
-    array_output_.Reset(buffer_.data(), buffer_.size());
+    buffer_pos_ = buffer_.data();
+    buffer_end_ = buffer_pos_ + buffer_.size();
 }
 
 void BufferedOutput::DoFlush() {
-    if (array_output_.Data() != buffer_.data()) {
-        destination_->Write(buffer_.data(), array_output_.Data() - buffer_.data());
+    if (buffer_pos_ != buffer_.data()) {
+        destination_->Write(buffer_.data(), buffer_pos_ - buffer_.data());
         destination_->Flush();
 
-        array_output_.Reset(buffer_.data(), buffer_.size());
+        Reset();
     }
 }
 
 size_t BufferedOutput::DoNext(void** data, size_t len) {
-    if (array_output_.Avail() < len) {
+    if (static_cast<size_t>(buffer_end_ - buffer_pos_) < len) {
         Flush();
     }
 
-    return array_output_.Next(data, len);
+    len = std::min(len, static_cast<size_t>(buffer_end_ - buffer_pos_));
 
+    *data = buffer_pos_;
+    buffer_pos_ += len;
+
+    return len;
 }
 
 size_t BufferedOutput::DoWrite(const void* data, size_t len) {
-    if (array_output_.Avail() < len) {
+    if (static_cast<size_t>(buffer_end_ - buffer_pos_) < len) {
         Flush();
 
         if (len > buffer_.size() / 2) {
@@ -106,7 +111,14 @@ size_t BufferedOutput::DoWrite(const void* data, size_t len) {
         }
     }
 
-    return array_output_.Write(data, len);
+    len = std::min(len, static_cast<size_t>(buffer_end_ - buffer_pos_));
+
+    if (len) {
+        memcpy(buffer_pos_, data, len);
+        buffer_pos_ += len;
+    }
+
+    return len;
 }
 
 }
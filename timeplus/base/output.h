@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include <memory.h>
 #include <memory>
@@ -20,6 +21,15 @@ public:
     }
 
     inline size_t Write(const void* data, size_t len) {
+        // Unbuffered streams have null buffer pointers, which memcpy must not get even for 0 bytes.
+        if (len == 0) {
+            return 0;
+        }
+        if (static_cast<size_t>(buffer_end_ - buffer_pos_) >= len) {
+            memcpy(buffer_pos_, data, len);
+            buffer_pos_ += len;
+            return len;
+        }
         return DoWrite(data, len);
     }
 
@@ -27,6 +37,14 @@ protected:
     virtual void DoFlush() { }
 
     virtual size_t DoWrite(const void* data, size_t len) = 0;
+
+protected:
+    /** Free space a buffering stream has at hand.
+     *
+     *  Write() fills it inline, going to DoWrite() only when the data doesn't fit.
+     */
+    uint8_t* buffer_pos_ = nullptr;
+    uint8_t* buffer_end_ = nullptr;
 };
 
 
@@ -113,6 +131,8 @@ private:
  *
  *  Any data goes to underlying stream only if internal buffer is full
  *  or when client invokes Flush() on this.
+ *  Free space of the buffer is exposed via OutputStream::buffer_pos_/buffer_end_,
+ *  so small writes (e.g. by WireFormat) don't go through virtual calls.
  *
  * Doesn't Flush() in destructor, client must ensure to do it manually at some point.
  */
@@ -131,7 +151,6 @@ protected:
 private:
     std::unique_ptr<OutputStream> const destination_;
     Buffer buffer_;
-    ArrayOutput array_output_;
 };
 
 template <typename T>
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace timeplus {
+
+/** Non-owning view of a contiguous sequence of elements, a minimal stand-in for C++20 std::span.
+ *
+ *  Element access is unchecked, so loops over a Span compile down to plain loads.
+ *  Span is valid as long as the storage it points to is not modified/reallocated.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)
+    {}
+
+    /// From any contiguous container with data() and size(), i.e. std::vector, std::array, std::string.
+    /// Temporaries are accepted as well, so a Span parameter can be passed e.g. std::vector<T>{...}.
+    template <typename Container, typename = std::enable_if_t<
+        std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container&& container) noexcept
+        : Span(container.data(), container.size())
+    {}
+
+    inline constexpr T* data() const noexcept { return data_; }
+    inline constexpr size_t size() const noexcept { return size_; }
+    inline constexpr bool empty() const noexcept { return size_ == 0; }
+
+    inline constexpr T& operator[](size_t index) const noexcept { return data_[index]; }
+    inline constexpr T& front() const noexcept { return data_[0]; }
+    inline constexpr T& back() const noexcept { return data_[size_ - 1]; }
+
+    inline constexpr iterator begin() const noexcept { return data_; }
+    inline constexpr iterator end() const noexcept { return data_ + size_; }
+
+    /// Returns view of `count` elements starting from `offset`, both must be within this Span.
+    inline constexpr Span subspan(size_t offset, size_t count) const noexcept {
+        return Span(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}
@@ -0,0 +1,479 @@
+#include "time_zone.h"
+
+#include "../exceptions.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+/// Transitions are precomputed up to this year, which covers the range of DateTime64.
+constexpr int32_t MAX_YEAR = 2300;
+
+inline int64_t FloorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+/// Days since 1970-01-01 of given proleptic Gregorian date, see http://howardhinnant.github.io/date_algorithms.html
+/// Plain integer arithmetic without branches on data, so loops over it are cheap.
+inline int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    const int64_t era = FloorDiv(year, 400);
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+inline void CivilFromDays(int64_t days, timeplus::CivilTime& result) {
+    days += 719468;
+    const int64_t era = FloorDiv(days, 146097);
+    const int64_t day_of_era = days - era * 146097;
+    const int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const int64_t month_index = (5 * day_of_year + 2) / 153;
+    const int64_t month = month_index < 10 ? month_index + 3 : month_index - 9;
+
+    result.year = static_cast<int32_t>(year_of_era + era * 400 + (month <= 2));
+    result.month = static_cast<uint8_t>(month);
+    result.day = static_cast<uint8_t>(day_of_year - (153 * month_index + 2) / 5 + 1);
+}
+
+inline bool IsLeapYear(int64_t year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+/// Rule for the date of DST start or end in POSIX TZ string, i.e. "M3.5.0" (last Sunday of March).
+struct DateRule {
+    char kind = 'M';    ///< 'J' - Julian day 1-365 ignoring February 29, 'N' - zero-based day 0-365, 'M' - month.week.weekday
+    int64_t day = 0;
+    int64_t month = 0;
+    int64_t week = 0;
+    int64_t weekday = 0;
+    int64_t time = 2 * 3600;  ///< local time of day of the change, may be negative or exceed 24 hours
+
+    /// Day since epoch the rule points to in given year.
+    int64_t DaysInYear(int64_t year) const {
+        const int64_t new_year = DaysFromCivil(year, 1, 1);
+        switch (kind) {
+            case 'J':
+                return new_year + day - 1 + (IsLeapYear(year) && day >= 60 ? 1 : 0);
+            case 'N':
+                return new_year + day;
+            default: {
+                const int64_t first = DaysFromCivil(year, month, 1);
+                const int64_t next_month = month == 12 ? DaysFromCivil(year + 1, 1, 1) : DaysFromCivil(year, month + 1, 1);
+                // 1970-01-01 is Thursday.
+                const int64_t first_weekday = ((first + 4) % 7 + 7) % 7;
+                int64_t result = first + (weekday - first_weekday + 7) % 7 + (week - 1) * 7;
+                while (result >= next_month) {
+                    result -= 7;
+                }
+                return result;
+            }
+        }
+    }
+};
+
+/// Parsed POSIX TZ string from the footer of TZif file, i.e. "CET-1CEST,M3.5.0,M10.5.0/3".
+struct PosixTimeZone {
+    int32_t std_offset = 0;
+    bool has_dst = false;
+    int32_t dst_offset = 0;
+    DateRule start;
+    DateRule end;
+};
+
+class PosixParser {
+public:
+    explicit PosixParser(const std::string& str)
+        : pos_(str.data())
+        , end_(str.data() + str.size())
+    {}
+
+    bool Parse(PosixTimeZone& result) {
+        if (!ParseName() || !ParseOffset(result.std_offset)) {
+            return false;
+        }
+        // POSIX offsets are west of Greenwich.
+        result.std_offset = -result.std_offset;
+        if (pos_ == end_) {
+            return true;
+        }
+
+        if (!ParseName()) {
+            return false;
+        }
+        result.has_dst = true;
+        result.dst_offset = result.std_offset + 3600;
+        if (pos_ != end_ && *pos_ != ',') {
+            if (!ParseOffset(result.dst_offset)) {
+                return false;
+            }
+            result.dst_offset = -result.dst_offset;
+        }
+
+        return Skip(',') && ParseDate(result.start) && Skip(',') && ParseDate(result.end) && pos_ == end_;
+    }
+
+private:
+    bool Skip(char c) {
+        if (pos_ == end_ || *pos_ != c) {
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    bool ParseName() {
+        const char* begin = pos_;
+        if (Skip('<')) {
+            while (pos_ != end_ && *pos_ != '>') {
+                ++pos_;
+            }
+            return Skip('>');
+        }
+        while (pos_ != end_ && ((*pos_ >= 'a' && *pos_ <= 'z') || (*pos_ >= 'A' && *pos_ <= 'Z'))) {
+            ++pos_;
+        }
+        return pos_ - begin >= 3;
+    }
+
+    bool ParseNumber(int64_t& result) {
+        if (pos_ == end_ || *pos_ < '0' || *pos_ > '9') {
+            return false;
+        }
+        result = 0;
+        while (pos_ != end_ && *pos_ >= '0' && *pos_ <= '9') {
+            result = result * 10 + (*pos_++ - '0');
+        }
+        return true;
+    }
+
+    /// [+|-]hh[:mm[:ss]]
+    bool ParseTime(int64_t& result) {
+        int64_t sign = 1;
+        if (Skip('-')) {
+            sign = -1;
+        } else {
+            Skip('+');
+        }
+
+        int64_t hours = 0, minutes = 0, seconds = 0;
+        if (!ParseNumber(hours)) {
+            return false;
+        }
+        if (Skip(':') && (!ParseNumber(minutes) || (Skip(':') && !ParseNumber(seconds)))) {
+            return false;
+        }
+        result = sign * (hours * 3600 + minutes * 60 + seconds);
+        return true;
+    }
+
+    bool ParseOffset(int32_t& result) {
+        int64_t offset = 0;
+        if (!ParseTime(offset)) {
+            return false;
+        }
+        result = static_cast<int32_t>(offset);
+        return true;
+    }
+
+    bool ParseDate(DateRule& rule) {
+        if (Skip('J')) {
+            rule.kind = 'J';
+            if (!ParseNumber(rule.day)) {
+                return false;
+            }
+        } else if (Skip('M')) {
+            rule.kind = 'M';
+            if (!ParseNumber(rule.month) || !Skip('.') || !ParseNumber(rule.week) || !Skip('.') || !ParseNumber(rule.weekday)) {
+                return false;
+            }
+            if (rule.month < 1 || rule.month > 12 || rule.week < 1 || rule.week > 5 || rule.weekday > 6) {
+                return false;
+            }
+        } else {
+            rule.kind = 'N';
+            if (!ParseNumber(rule.day)) {
+                return false;
+            }
+        }
+        return !Skip('/') || ParseTime(rule.time);
+    }
+
+private:
+    const char* pos_;
+    const char* end_;
+};
+
+class TZifReader {
+public:
+    explicit TZifReader(const std::string& data)
+        : data_(data)
+    {}
+
+    /// Reads transitions (skipping ones which don't change the offset) and the footer of TZif file, see RFC 8536.
+    bool Read(std::vector<int64_t>& transitions, std::vector<int32_t>& offsets, std::string& footer) {
+        Header header;
+        if (!ReadHeader(0, header)) {
+            return false;
+        }
+
+        size_t pos = HEADER_SIZE;
+        size_t time_size = 4;
+        if (header.version >= '2') {
+            // Skip version 1 data, version 2+ one repeats it with 64-bit times.
+            pos += header.DataSize(4);
+            if (!ReadHeader(pos, header)) {
+                return false;
+            }
+            pos += HEADER_SIZE;
+            time_size = 8;
+        }
+        if (header.type_count == 0 || pos + header.DataSize(time_size) > data_.size()) {
+            return false;
+        }
+
+        const size_t indices_pos = pos + header.time_count * time_size;
+        const size_t types_pos = indices_pos + header.time_count;
+
+        const auto utc_offset = [&] (size_t type) {
+            return static_cast<int32_t>(ReadUInt32(types_pos + type * 6));
+        };
+
+        transitions.assign(1, std::numeric_limits<int64_t>::min());
+        offsets.assign(1, utc_offset(0));
+        for (size_t i = 0; i < header.time_count; ++i) {
+            const int64_t time = time_size == 8
+                ? static_cast<int64_t>(ReadUInt64(pos + i * 8))
+                : static_cast<int64_t>(static_cast<int32_t>(ReadUInt32(pos + i * 4)));
+            const auto type = static_cast<uint8_t>(data_[indices_pos + i]);
+            if (type >= header.type_count) {
+                return false;
+            }
+            if (utc_offset(type) != offsets.back()) {
+                transitions.push_back(time);
+                offsets.push_back(utc_offset(type));
+            }
+        }
+
+        footer.clear();
+        if (header.version >= '2') {
+            const size_t footer_pos = pos + header.DataSize(time_size);
+            if (footer_pos < data_.size() && data_[footer_pos] == '\n') {
+                const size_t footer_end = data_.find('\n', footer_pos + 1);
+                if (footer_end != std::string::npos) {
+                    footer = data_.substr(footer_pos + 1, footer_end - footer_pos - 1);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t HEADER_SIZE = 44;
+
+    struct Header {
+        char version = 0;
+        size_t is_ut_count = 0;
+        size_t is_std_count = 0;
+        size_t leap_count = 0;
+        size_t time_count = 0;
+        size_t type_count = 0;
+        size_t char_count = 0;
+
+        size_t DataSize(size_t time_size) const {
+            return time_count * time_size + time_count + type_count * 6 + char_count
+                + leap_count * (time_size + 4) + is_std_count + is_ut_count;
+        }
+    };
+
+    bool ReadHeader(size_t pos, Header& header) const {
+        if (pos + HEADER_SIZE > data_.size() || data_.compare(pos, 4, "TZif") != 0) {
+            return false;
+        }
+        header.version = data_[pos + 4];
+        header.is_ut_count = ReadUInt32(pos + 20);
+        header.is_std_count = ReadUInt32(pos + 24);
+        header.leap_count = ReadUInt32(pos + 28);
+        header.time_count = ReadUInt32(pos + 32);
+        header.type_count = ReadUInt32(pos + 36);
+        header.char_count = ReadUInt32(pos + 40);
+        return true;
+    }
+
+    uint32_t ReadUInt32(size_t pos) const {
+        uint32_t result = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            result = (result << 8) | static_cast<uint8_t>(data_[pos + i]);
+        }
+        return result;
+    }
+
+    uint64_t ReadUInt64(size_t pos) const {
+        return (static_cast<uint64_t>(ReadUInt32(pos)) << 32) | ReadUInt32(pos + 4);
+    }
+
+private:
+    const std::string& data_;
+};
+
+std::string ReadTimeZoneFile(const std::string& name) {
+    // Names are relative paths within the database, don't let them point outside of it.
+    if (name.empty() || name.front() == '/' || name.find("..") != std::string::npos) {
+        throw timeplus::ValidationError("invalid timezone name '" + name + "'");
+    }
+
+    const char* directory = std::getenv("TZDIR");
+    const std::string path = std::string(directory && *directory ? directory : "/usr/share/zoneinfo") + "/" + name;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw timeplus::ValidationError("unknown timezone '" + name + "': can't open " + path);
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+}
+
+namespace timeplus {
+
+TimeZone::TimeZone(std::string name)
+    : name_(std::move(name))
+    , transitions_(1, std::numeric_limits<int64_t>::min())
+    , offsets_(1, 0)
+{
+    if (!name_.empty() && name_ != "UTC") {
+        std::string footer;
+        if (!TZifReader(ReadTimeZoneFile(name_)).Read(transitions_, offsets_, footer)) {
+            throw ValidationError("timezone '" + name_ + "' has invalid or unsupported format");
+        }
+
+        // Offset changes after the last listed transition are described by the POSIX TZ string in the footer.
+        PosixTimeZone rule;
+        if (!footer.empty() && PosixParser(footer).Parse(rule) && rule.has_dst) {
+            const int64_t last = transitions_.back();
+            int64_t year = 1900;
+            if (transitions_.size() > 1) {
+                CivilTime civil;
+                CivilFromDays(FloorDiv(last, SECONDS_PER_DAY), civil);
+                year = civil.year;
+            }
+
+            for (; year <= MAX_YEAR; ++year) {
+                const int64_t start = rule.start.DaysInYear(year) * SECONDS_PER_DAY + rule.start.time - rule.std_offset;
+                const int64_t end = rule.end.DaysInYear(year) * SECONDS_PER_DAY + rule.end.time - rule.dst_offset;
+                // In the southern hemisphere DST ends earlier in the year than it starts.
+                const std::pair<int64_t, int32_t> changes[] = {
+                    start < end ? std::make_pair(start, rule.dst_offset) : std::make_pair(end, rule.std_offset),
+                    start < end ? std::make_pair(end, rule.std_offset) : std::make_pair(start, rule.dst_offset),
+                };
+                for (const auto& [time, offset] : changes) {
+                    if (time > transitions_.back() && offset != offsets_.back()) {
+                        transitions_.push_back(time);
+                        offsets_.push_back(offset);
+                    }
+                }
+            }
+        }
+    }
+
+    local_transitions_.reserve(transitions_.size());
+    local_transitions_.push_back(std::numeric_limits<int64_t>::min());
+    for (size_t i = 1; i < transitions_.size(); ++i) {
+        local_transitions_.push_back(transitions_[i] + std::max(offsets_[i - 1], offsets_[i]));
+    }
+}
+
+std::shared_ptr<const TimeZone> TimeZone::Get(const std::string& name) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const TimeZone>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& time_zone = cache[name];
+    if (!time_zone) {
+        try {
+            time_zone = std::make_shared<const TimeZone>(name);
+        } catch (...) {
+            cache.erase(name);
+            throw;
+        }
+    }
+    return time_zone;
+}
+
+size_t TimeZone::FindUtcInterval(int64_t time, size_t hint) const {
+    if (transitions_[hint] <= time && (hint + 1 == transitions_.size() || time < transitions_[hint + 1])) {
+        return hint;
+    }
+    return static_cast<size_t>(std::upper_bound(transitions_.begin(), transitions_.end(), time) - transitions_.begin()) - 1;
+}
+
+size_t TimeZone::FindLocalInterval(int64_t local_time, size_t hint) const {
+    if (local_transitions_[hint] <= local_time && (hint + 1 == local_transitions_.size() || local_time < local_transitions_[hint + 1])) {
+        return hint;
+    }
+    return static_cast<size_t>(std::upper_bound(local_transitions_.begin(), local_transitions_.end(), local_time) - local_transitions_.begin()) - 1;
+}
+
+int32_t TimeZone::UtcOffset(int64_t time) const {
+    return offsets_[FindUtcInterval(time, 0)];
+}
+
+CivilTime TimeZone::ToCivil(int64_t time) const {
+    CivilTime result;
+    ToCivil(&time, 1, &result);
+    return result;
+}
+
+int64_t TimeZone::FromCivil(const CivilTime& time) const {
+    int64_t result = 0;
+    FromCivil(&time, 1, &result);
+    return result;
+}
+
+void TimeZone::ToCivil(const int64_t* times, size_t count, CivilTime* output) const {
+    size_t interval = 0;
+    for (size_t i = 0; i < count; ++i) {
+        interval = FindUtcInterval(times[i], interval);
+        const int64_t local_time = times[i] + offsets_[interval];
+        const int64_t days = FloorDiv(local_time, SECONDS_PER_DAY);
+        const int64_t seconds = local_time - days * SECONDS_PER_DAY;
+
+        CivilTime& result = output[i];
+        CivilFromDays(days, result);
+        result.hour = static_cast<uint8_t>(seconds / 3600);
+        result.minute = static_cast<uint8_t>(seconds / 60 % 60);
+        result.second = static_cast<uint8_t>(seconds % 60);
+        result.nanosecond = 0;
+    }
+}
+
+void TimeZone::FromCivil(const CivilTime* times, size_t count, int64_t* output) const {
+    size_t interval = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const CivilTime& time = times[i];
+        if (time.month < 1 || time.month > 12) {
+            throw ValidationError("month " + std::to_string(time.month) + " is out of range");
+        }
+
+        const int64_t local_time = DaysFromCivil(time.year, time.month, time.day) * SECONDS_PER_DAY
+            + time.hour * 3600 + time.minute * 60 + time.second;
+        interval = FindLocalInterval(local_time, interval);
+        output[i] = local_time - offsets_[interval];
+    }
+}
+
+}
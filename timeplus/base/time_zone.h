@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace timeplus {
+
+/// Broken-down (wall clock) time, as seen in some timezone.
+struct CivilTime {
+    int32_t year = 1970;
+    uint8_t month = 1;      ///< 1 - 12
+    uint8_t day = 1;        ///< 1 - 31
+    uint8_t hour = 0;
+    uint8_t minute = 0;
+    uint8_t second = 0;
+    uint32_t nanosecond = 0;
+
+    bool operator==(const CivilTime& other) const {
+        return year == other.year && month == other.month && day == other.day && hour == other.hour
+            && minute == other.minute && second == other.second && nanosecond == other.nanosecond;
+    }
+    bool operator!=(const CivilTime& other) const { return !(*this == other); }
+};
+
+/** Timezone loaded from the system tz database (TZDIR or /usr/share/zoneinfo).
+ *
+ *  All offset changes within years 1900 - 2300 are precomputed once into a table of transitions,
+ *  so conversions don't touch libc (no localtime_r, no lock on the global timezone state).
+ *  Bulk conversions remember the interval between transitions the previous value fell into,
+ *  so for values close to each other (as in most columns) there is no search at all.
+ */
+class TimeZone {
+public:
+    /// Returns timezone by IANA name, e.g. "Europe/Berlin"; empty name means UTC.
+    /// Timezones are loaded once and cached, ValidationError is thrown if there is no such timezone.
+    static std::shared_ptr<const TimeZone> Get(const std::string& name);
+
+    /// Loads timezone without caching it, Get() should be preferred.
+    explicit TimeZone(std::string name);
+
+    const std::string& Name() const { return name_; }
+
+    /// Offset from UTC in seconds at given UTC time.
+    int32_t UtcOffset(int64_t time) const;
+
+    /// Converts UTC time (seconds since epoch) to civil time.
+    CivilTime ToCivil(int64_t time) const;
+
+    /** Converts civil time to UTC (seconds since epoch, `nanosecond` is ignored).
+     *
+     *  Day and time of day out of range are normalized as with timegm, i.e. February 30 is March 1 or 2.
+     *  Time repeated when clocks are turned back is taken at its first occurrence;
+     *  time skipped when clocks are turned forward is shifted forward by the size of the gap.
+     *  Throws ValidationError if month is out of range.
+     */
+    int64_t FromCivil(const CivilTime& time) const;
+
+    /// Bulk versions of the above.
+    void ToCivil(const int64_t* times, size_t count, CivilTime* output) const;
+    void FromCivil(const CivilTime* times, size_t count, int64_t* output) const;
+
+private:
+    size_t FindUtcInterval(int64_t time, size_t hint) const;
+    size_t FindLocalInterval(int64_t local_time, size_t hint) const;
+
+private:
+    std::string name_;
+    /// UTC times of offset changes, offsets_[i] is in effect since transitions_[i] (offsets_[0] since forever).
+    std::vector<int64_t> transitions_;
+    std::vector<int32_t> offsets_;
+    /// Local times since which offsets_[i] is used for conversion from civil time.
+    std::vector<int64_t> local_transitions_;
+};
+
+}
@@ -450,6 +450,19 @@ private:
         constexpr const unsigned rhs_items = (sizeof(T) > sizeof(base_type)) ? (sizeof(T) / sizeof(base_type)) : 1;
         constexpr const unsigned op_items = (item_count < rhs_items) ? item_count : rhs_items;
 
+        if constexpr (Bits == 128 && sizeof(base_type) == 8)
+        {
+            using CompilerUInt128 = unsigned __int128;
+            const CompilerUInt128 a = (CompilerUInt128(lhs.items[1]) << 64) + lhs.items[0];
+            const CompilerUInt128 b = (CompilerUInt128(get_item(rhs, 1)) << 64) + get_item(rhs, 0);
+            const CompilerUInt128 c = a - b;
+
+            integer<Bits, Signed> res;
+            res.items[0] = static_cast<base_type>(c);
+            res.items[1] = static_cast<base_type>(c >> 64);
+            return res;
+        }
+
         integer<Bits, Signed> res(lhs);
         bool underflows[item_count] = {};
 
@@ -483,6 +496,19 @@ private:
         constexpr const unsigned rhs_items = (sizeof(T) > sizeof(base_type)) ? (sizeof(T) / sizeof(base_type)) : 1;
         constexpr const unsigned op_items = (item_count < rhs_items) ? item_count : rhs_items;
 
+        if constexpr (Bits == 128 && sizeof(base_type) == 8)
+        {
+            using CompilerUInt128 = unsigned __int128;
+            const CompilerUInt128 a = (CompilerUInt128(lhs.items[1]) << 64) + lhs.items[0];
+            const CompilerUInt128 b = (CompilerUInt128(get_item(rhs, 1)) << 64) + get_item(rhs, 0);
+            const CompilerUInt128 c = a + b;
+
+            integer<Bits, Signed> res;
+            res.items[0] = static_cast<base_type>(c);
+            res.items[1] = static_cast<base_type>(c >> 64);
+            return res;
+        }
+
         integer<Bits, Signed> res(lhs);
         bool overflows[item_count] = {};
 
@@ -564,8 +590,8 @@ private:
             CompilerUInt128 b = (CompilerUInt128(rhs.items[1]) << 64) + rhs.items[0]; // NOLINT(clang-analyzer-core.UndefinedBinaryOperatorResult)
             CompilerUInt128 c = a * b;
             integer<Bits, Signed> res;
-            res.items[0] = c;
-            res.items[1] = c >> 64;
+            res.items[0] = static_cast<base_type>(c);
+            res.items[1] = static_cast<base_type>(c >> 64);
             return res;
         }
         else
@@ -830,12 +856,12 @@ public:
             CompilerUInt128 c = a / b; // NOLINT
 
             integer<Bits, Signed> res;
-            res.items[0] = c;
-            res.items[1] = c >> 64;
+            res.items[0] = static_cast<base_type>(c);
+            res.items[1] = static_cast<base_type>(c >> 64);
 
             CompilerUInt128 remainder = a - b * c;
-            numerator.items[0] = remainder;
-            numerator.items[1] = remainder >> 64;
+            numerator.items[0] = static_cast<base_type>(remainder);
+            numerator.items[1] = static_cast<base_type>(remainder >> 64);
 
             return res;
         }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <ostream>
+#include <type_traits>
 // #include <fmt/format.h>
 
 #include "wide_integer.h"
@@ -10,13 +14,82 @@
 namespace wide
 {
 
+namespace details
+{
+
+/// Base-10 conversions work on chunks of 19 digits (the largest power of 10 fitting into 64 bits)
+/// with one hardware division or multiplication per 64-bit limb, instead of the generic
+/// bit-by-bit division and limb-by-limb multiplication of wide::integer for every single digit.
+constexpr size_t CHUNK_DIGITS = 19;
+
+constexpr uint64_t POW10[CHUNK_DIGITS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+/// Divides `value` by `divisor` in place, returns the remainder.
+template <size_t Bits>
+inline uint64_t divide(integer<Bits, unsigned> & value, uint64_t divisor)
+{
+#if defined(__SIZEOF_INT128__)
+    using Impl = typename integer<Bits, unsigned>::_impl;
+
+    // Remainder is always less than divisor, so every step is a 128 by 64 bit division with 64-bit quotient.
+    uint64_t remainder = 0;
+    for (unsigned i = 0; i < Impl::item_count; ++i)
+    {
+        auto & item = value.items[Impl::big(i)];
+        if (remainder == 0)
+        {
+            // i.e. leading zero limbs, which are common as the value shrinks.
+            remainder = item % divisor;
+            item /= divisor;
+            continue;
+        }
+        const unsigned __int128 current = (static_cast<unsigned __int128>(remainder) << 64) | item;
+        item = static_cast<uint64_t>(current / divisor);
+        remainder = static_cast<uint64_t>(current % divisor);
+    }
+    return remainder;
+#else
+    const integer<Bits, unsigned> quotient = value / divisor;
+    const auto remainder = static_cast<uint64_t>(value - quotient * divisor);
+    value = quotient;
+    return remainder;
+#endif
+}
+
+/// Sets `value` to value * multiplier + addend, returns non-zero if the result doesn't fit (is truncated).
+template <size_t Bits>
+inline uint64_t multiply_add(integer<Bits, unsigned> & value, uint64_t multiplier, uint64_t addend)
+{
+#if defined(__SIZEOF_INT128__)
+    using Impl = typename integer<Bits, unsigned>::_impl;
+
+    uint64_t carry = addend;
+    for (unsigned i = 0; i < Impl::item_count; ++i)
+    {
+        auto & item = value.items[Impl::little(i)];
+        const unsigned __int128 current = static_cast<unsigned __int128>(item) * multiplier + carry;
+        item = static_cast<uint64_t>(current);
+        carry = static_cast<uint64_t>(current >> 64);
+    }
+    return carry;
+#else
+    const auto max = std::numeric_limits<integer<Bits, unsigned>>::max();
+    const bool overflows = multiplier != 0 && value > (max - addend) / multiplier;
+    value = value * multiplier + addend;
+    return overflows;
+#endif
+}
+
+}
+
 template <size_t Bits, typename Signed>
 inline std::string to_string(const integer<Bits, Signed> & n)
 {
-    std::string res;
-    if (integer<Bits, Signed>::_impl::operator_eq(n, 0U))
-        return "0";
-
     integer<Bits, unsigned> t;
     bool is_neg = integer<Bits, Signed>::_impl::is_negative(n);
     if (is_neg)
@@ -24,15 +97,77 @@ inline std::string to_string(const integer<Bits, Signed> & n)
     else
         t = n;
 
-    while (!integer<Bits, unsigned>::_impl::operator_eq(t, 0U))
+    // Up to Bits * log10(2) digits (plus the partial one) and the sign, filled from the end.
+    char buffer[Bits * 30103 / 100000 + 3];
+    char * const end = buffer + sizeof(buffer);
+    char * begin = end;
+
+    do
     {
-        res.insert(res.begin(), '0' + char(integer<Bits, unsigned>::_impl::operator_percent(t, 10U)));
-        t = integer<Bits, unsigned>::_impl::operator_slash(t, 10U);
-    }
+        uint64_t chunk = details::divide(t, details::POW10[details::CHUNK_DIGITS]);
+        // All chunks but the most significant one are padded with zeros to the full size.
+        const bool is_last = integer<Bits, unsigned>::_impl::is_zero(t);
+        for (size_t i = 0; i < details::CHUNK_DIGITS && (chunk != 0 || !is_last); ++i)
+        {
+            *--begin = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    } while (!integer<Bits, unsigned>::_impl::is_zero(t));
 
+    if (begin == end)
+        *--begin = '0';
     if (is_neg)
-        res.insert(res.begin(), '-');
-    return res;
+        *--begin = '-';
+    return std::string(begin, end);
+}
+
+/** Parses decimal digits of `str`, preceded by '-' for negative values of signed types.
+ *
+ *  Returns false, leaving `result` intact, if `str` is empty, has any other characters, or the value doesn't fit.
+ */
+template <size_t Bits, typename Signed>
+inline bool from_string(std::string_view str, integer<Bits, Signed> & result)
+{
+    const bool is_neg = std::is_same_v<Signed, signed> && !str.empty() && str.front() == '-';
+    if (is_neg)
+        str.remove_prefix(1);
+    if (str.empty())
+        return false;
+
+    integer<Bits, unsigned> magnitude = 0;
+
+    // The leading chunk is the short one, so that all others have exactly CHUNK_DIGITS digits.
+    size_t chunk_size = str.size() % details::CHUNK_DIGITS;
+    if (chunk_size == 0)
+        chunk_size = details::CHUNK_DIGITS;
+
+    for (size_t pos = 0; pos < str.size(); pos += chunk_size, chunk_size = details::CHUNK_DIGITS)
+    {
+        uint64_t chunk = 0;
+        for (size_t i = pos; i < pos + chunk_size; ++i)
+        {
+            const unsigned digit = static_cast<unsigned char>(str[i]) - unsigned('0');
+            if (digit > 9)
+                return false;
+            chunk = chunk * 10 + digit;
+        }
+
+        if (details::multiply_add(magnitude, details::POW10[chunk_size], chunk) != 0)
+            return false;
+    }
+
+    if constexpr (std::is_same_v<Signed, signed>)
+    {
+        // Magnitude of the minimal value is one more than of the maximal one.
+        integer<Bits, unsigned> max_magnitude = std::numeric_limits<integer<Bits, signed>>::max();
+        if (is_neg)
+            ++max_magnitude;
+        if (magnitude > max_magnitude)
+            return false;
+    }
+
+    result = is_neg ? -integer<Bits, Signed>(magnitude) : integer<Bits, Signed>(magnitude);
+    return true;
 }
 
 }
@@ -44,4 +179,4 @@ inline std::ostream & operator<<(std::ostream & out, const wide::integer<Bits, S
 {
     return out << wide::to_string(value);
 }
-}
\ No newline at end of file
+}
@@ -1,41 +1,47 @@
 #include "wire_format.h"
 
-#include "input.h"
-#include "output.h"
-
 #include "../exceptions.h"
 
 #include <stdexcept>
 
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
 namespace {
-constexpr int MAX_VARINT_BYTES = 10;
+inline uint64_t AssembleVarint64(const uint8_t* data, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value |= uint64_t(data[i] & 0x7F) << (7 * i);
+    }
+    return value;
+}
 }
 
 namespace timeplus {
 
-bool WireFormat::ReadAll(InputStream& input, void* buf, size_t len) {
-    uint8_t* p = static_cast<uint8_t*>(buf);
-
+bool WireFormat::ReadRemaining(InputStream& input, uint8_t* buf, size_t len) {
     size_t read_previously = 1; // 1 to execute loop at least once
     while (len > 0 && read_previously) {
-        read_previously = input.Read(p, len);
+        read_previously = input.Read(buf, len);
 
-        p += read_previously;
+        buf += read_previously;
         len -= read_previously;
     }
 
     return !len;
 }
 
-void WireFormat::WriteAll(OutputStream& output, const void* buf, size_t len) {
+void WireFormat::WriteRemaining(OutputStream& output, const uint8_t* buf, size_t len, size_t written) {
     const size_t original_len = len;
-    const uint8_t* p = static_cast<const uint8_t*>(buf);
+    buf += written;
+    len -= written;
 
-    size_t written_previously = 1; // 1 to execute loop at least once
+    size_t written_previously = written;
     while (len > 0 && written_previously) {
-        written_previously = output.Write(p, len);
+        written_previously = output.Write(buf, len);
 
-        p += written_previously;
+        buf += written_previously;
         len -= written_previously;
     }
 
@@ -48,7 +54,7 @@ void WireFormat::WriteAll(OutputStream& output, const void* buf, size_t len) {
 bool WireFormat::ReadVarint64(InputStream& input, uint64_t* value) {
     *value = 0;
 
-    for (size_t i = 0; i < MAX_VARINT_BYTES; ++i) {
+    for (size_t i = 0; i < MAX_VARINT64_BYTES; ++i) {
         uint8_t byte = 0;
 
         if (!input.ReadByte(&byte)) {
@@ -66,23 +72,38 @@ bool WireFormat::ReadVarint64(InputStream& input, uint64_t* value) {
     return false;
 }
 
-void WireFormat::WriteVarint64(OutputStream& output, uint64_t value) {
-    uint8_t bytes[MAX_VARINT_BYTES];
-    int size = 0;
-
-    for (size_t i = 0; i < MAX_VARINT_BYTES; ++i) {
-        uint8_t byte = value & 0x7F;
-        if (value > 0x7F)
-            byte |= 0x80;
+size_t WireFormat::DecodeVarint64Multibyte(const uint8_t* data, size_t len, uint64_t* value) {
+#if defined(__SSE2__)
+    if (len >= 16) {
+        // Find the terminating byte (the one without continuation bit) for all 16 bytes at once,
+        // so the value is assembled without a data-dependent branch per byte.
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const unsigned terminators = ~static_cast<unsigned>(_mm_movemask_epi8(bytes)) & 0xFFFFu;
+        const size_t size = static_cast<size_t>(__builtin_ctz(terminators | 0x10000u)) + 1;
+
+        if (size > MAX_VARINT64_BYTES) {
+            return 0;
+        }
 
-        bytes[size++] = byte;
+        *value = AssembleVarint64(data, size);
+        return size;
+    }
+#endif
 
-        value >>= 7;
-        if (!value) {
-            break;
+    for (size_t i = 0; i < len && i < MAX_VARINT64_BYTES; ++i) {
+        if (!(data[i] & 0x80)) {
+            *value = AssembleVarint64(data, i + 1);
+            return i + 1;
         }
     }
 
+    return 0;
+}
+
+void WireFormat::WriteVarint64(OutputStream& output, uint64_t value) {
+    uint8_t bytes[MAX_VARINT64_BYTES];
+    const size_t size = EncodeVarint64(value, bytes);
+
     WriteAll(output, bytes, size);
 }
 
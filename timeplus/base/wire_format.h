@@ -1,13 +1,13 @@
 #pragma once
 
+#include "input.h"
+#include "output.h"
+
 #include <string>
 #include <cstdint>
 
 namespace timeplus {
 
-class InputStream;
-class OutputStream;
-
 class WireFormat {
 public:
     template <typename T>
@@ -25,11 +25,41 @@ public:
     static void WriteUInt64(OutputStream& output, const uint64_t value);
     static void WriteVarint64(OutputStream& output, uint64_t value);
 
+    /// Maximum number of bytes in varint-encoded 64-bit value.
+    static constexpr size_t MAX_VARINT64_BYTES = 10;
+
+    /** Decodes varint from a contiguous memory block, without touching any stream.
+     *
+     *  Returns number of bytes consumed, or 0 if the block ends before the value does
+     *  or the value is malformed.
+     */
+    static size_t DecodeVarint64(const uint8_t* data, size_t len, uint64_t* value);
+    /// Encodes value into `out` which must have at least MAX_VARINT64_BYTES bytes, returns encoded size.
+    static size_t EncodeVarint64(uint64_t value, uint8_t* out);
+
 private:
+    static size_t DecodeVarint64Multibyte(const uint8_t* data, size_t len, uint64_t* value);
+
+    /// Inline, so that values the stream has buffered are transferred without a single virtual call.
     static bool ReadAll(InputStream& input, void* buf, size_t len);
     static void WriteAll(OutputStream& output, const void* buf, size_t len);
+    /// Slow paths, for values that cross buffer boundary or streams without buffer.
+    static bool ReadRemaining(InputStream& input, uint8_t* buf, size_t len);
+    static void WriteRemaining(OutputStream& output, const uint8_t* buf, size_t len, size_t written);
 };
 
+inline bool WireFormat::ReadAll(InputStream& input, void* buf, size_t len) {
+    const size_t read = input.Read(buf, len);
+    return read == len || (read && ReadRemaining(input, static_cast<uint8_t*>(buf) + read, len - read));
+}
+
+inline void WireFormat::WriteAll(OutputStream& output, const void* buf, size_t len) {
+    const size_t written = output.Write(buf, len);
+    if (written != len) {
+        WriteRemaining(output, static_cast<const uint8_t*>(buf), len, written);
+    }
+}
+
 template <typename T>
 inline bool WireFormat::ReadFixed(InputStream& input, T* value) {
     return ReadAll(input, value, sizeof(T));
@@ -48,6 +78,27 @@ inline bool WireFormat::ReadString(InputStream& input, std::string* value) {
     return false;
 }
 
+inline size_t WireFormat::DecodeVarint64(const uint8_t* data, size_t len, uint64_t* value) {
+    // Most lengths in a string column are shorter than 128 bytes.
+    if (len && data[0] < 0x80) {
+        *value = data[0];
+        return 1;
+    }
+
+    return DecodeVarint64Multibyte(data, len, value);
+}
+
+inline size_t WireFormat::EncodeVarint64(uint64_t value, uint8_t* out) {
+    size_t size = 0;
+    while (value > 0x7F) {
+        out[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+
+    return size;
+}
+
 inline bool WireFormat::ReadBytes(InputStream& input, void* buf, size_t len) {
     return ReadAll(input, buf, len);
 }
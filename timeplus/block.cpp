@@ -100,6 +100,22 @@ size_t Block::RefreshRowCount()
     return rows_;
 }
 
+size_t Block::ByteSize() const {
+    size_t result = 0;
+    for (const auto & column : columns_) {
+        result += column.column->ByteSize();
+    }
+    return result;
+}
+
+size_t Block::AllocatedBytes() const {
+    size_t result = 0;
+    for (const auto & column : columns_) {
+        result += column.column->AllocatedBytes();
+    }
+    return result;
+}
+
 ColumnRef Block::operator [] (size_t idx) const {
     if (idx < columns_.size()) {
         return columns_[idx].column;
@@ -81,6 +81,12 @@ public:
 
     size_t RefreshRowCount();
 
+    /// Size of data of all columns in bytes, see Column::ByteSize().
+    size_t ByteSize() const;
+
+    /// Memory held by all columns in bytes, see Column::AllocatedBytes().
+    size_t AllocatedBytes() const;
+
     const std::string& GetColumnName(size_t idx) const {
         return columns_.at(idx).name;
     }
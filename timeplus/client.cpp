@@ -89,7 +89,9 @@ std::ostream& operator<<(std::ostream& os, const ClientOptions& opt) {
        << " compression_method:"
        << (opt.compression_method == CompressionMethod::LZ4    ? "LZ4"
            : opt.compression_method == CompressionMethod::ZSTD ? "ZSTD"
-                                                               : "None");
+                                                               : "None")
+       << " zstd_compression_level:" << opt.zstd_compression_level
+       << " string_compact_layout:" << opt.string_compact_layout;
 #if defined(WITH_OPENSSL)
     if (opt.ssl_options) {
         const auto & ssl_options = *opt.ssl_options;
@@ -646,6 +648,7 @@ bool Client::Impl::ReadBlock(InputStream& input, Block* block) {
 
     CreateColumnByTypeSettings create_column_settings;
     create_column_settings.low_cardinality_as_wrapped_column = options_.backward_compatibility_lowcardinality_as_wrapped_column;
+    create_column_settings.string_compact_layout = options_.string_compact_layout;
 
     for (size_t i = 0; i < num_columns; ++i) {
         std::string name;
@@ -889,7 +892,7 @@ void Client::Impl::SendData(const Block& block) {
 
     if (compression_ == CompressionState::Enable) {
 
-        std::unique_ptr<OutputStream> compressed_output = std::make_unique<CompressedOutput>(output_.get(), options_.max_compression_chunk_size, options_.compression_method);
+        std::unique_ptr<OutputStream> compressed_output = std::make_unique<CompressedOutput>(output_.get(), options_.max_compression_chunk_size, options_.compression_method, options_.zstd_compression_level);
         BufferedOutput buffered(std::move(compressed_output), options_.max_compression_chunk_size);
 
         WriteBlock(block, buffered);
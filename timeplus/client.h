@@ -2,8 +2,11 @@
 
 #include "query.h"
 #include "exceptions.h"
+#include "row_mapping.h"
+#include "typed_block.h"
 
 #include "columns/array.h"
+#include "columns/columnview.h"
 #include "columns/date.h"
 #include "columns/decimal.h"
 #include "columns/enum.h"
@@ -46,6 +49,9 @@ enum class CompressionMethod : int8_t {
     ZSTD = 2,
 };
 
+/// ZSTD compression level used unless ClientOptions::zstd_compression_level is set: fast, with a decent ratio.
+constexpr int DEFAULT_ZSTD_COMPRESSION_LEVEL = 1;
+
 struct Endpoint {
     std::string host;
     uint16_t port = 8463;
@@ -135,6 +141,20 @@ struct ClientOptions {
      */
     DECLARE_FIELD(max_compression_chunk_size, unsigned int, SetMaxCompressionChunkSize, 65535);
 
+    /** Compression level used when compression_method is ZSTD.
+     *
+     *  Each chunk is sent as an independent ZSTD frame (server decodes it without any shared dictionary),
+     *  so higher levels are the only way to trade CPU for a better ratio on repetitive payloads.
+     */
+    DECLARE_FIELD(zstd_compression_level, int, SetZstdCompressionLevel, DEFAULT_ZSTD_COMPRESSION_LEVEL);
+
+    /** Create String columns of received blocks with ColumnString::Layout::Compact.
+     *
+     *  Values are read straight into one contiguous buffer with an offsets array, which is
+     *  cheaper to load and to hand over to columnar consumers than per-value string_view's.
+     */
+    DECLARE_FIELD(string_compact_layout, bool, SetStringCompactLayout, false);
+
     struct SSLOptions {
         /** There are two ways to configure an SSL connection:
          *  - provide a pre-configured SSL_CTX, which is not modified and not owned by the Client.
@@ -256,6 +276,13 @@ public:
     void Insert(const std::string& table_name, const Block& block, const std::string & idempotent_id = "");
     void Insert(const std::string& table_name, const std::string & query_id, const Block& block, const std::string & idempotent_id = "");
 
+    /// Intends for insert rows held in structs into a table \p table_name, with mapping declared by TIMEPLUS_ROW_MAPPING(Struct, ...).
+    /// Insertion will be idempotent when `idempotent_id` is not empty.
+    template <typename Struct>
+    void Insert(const std::string& table_name, const std::vector<Struct>& rows, const std::string & idempotent_id = "") {
+        Insert(table_name, RowMappingOf<Struct>::Get().ToBlock(rows), idempotent_id);
+    }
+
     /// Ping server for aliveness.
     void Ping();
 
@@ -2,6 +2,7 @@
 #include "numeric.h"
 
 #include <stdexcept>
+#include <string>
 
 namespace timeplus {
 
@@ -30,6 +31,30 @@ void ColumnArray::AppendAsColumn(ColumnRef array) {
     AddOffset(array->Size());
 }
 
+void ColumnArray::EndRow() {
+    offsets_->Append(data_->Size());
+}
+
+void ColumnArray::AppendRows(Span<const uint64_t> offsets, ColumnRef values) {
+    CheckOffsets(offsets, values->Size());
+    if (!values->Type()->IsEqual(data_->Type())) {
+        throw ValidationError("Can't append items of type " + values->Type()->GetName() + " to " + Type()->GetName());
+    }
+
+    data_->Append(values);
+    AppendOffsets(offsets);
+}
+
+void ColumnArray::EndRows(Span<const uint64_t> offsets) {
+    const auto & data = offsets_->GetData();
+    CheckOffsets(offsets, data_->Size() - (data.empty() ? 0 : data.back()));
+    AppendOffsets(offsets);
+}
+
+Span<const uint64_t> ColumnArray::GetOffsets() const {
+    return offsets_->GetData();
+}
+
 ColumnRef ColumnArray::GetAsColumn(size_t n) const {
     if (n >= Size())
         throw ValidationError("Index is out ouf bounds: " + std::to_string(n));
@@ -59,9 +84,19 @@ void ColumnArray::Reserve(size_t new_cap) {
 
 void ColumnArray::Append(ColumnRef column) {
     if (auto col = column->As<ColumnArray>()) {
-        for (size_t i = 0; i < col->Size(); ++i) {
-            AppendAsColumn(col->GetAsColumn(i));
+        if (col.get() == this) {
+            col = Slice(0, Size())->As<ColumnArray>();
         }
+
+        // Append all items at once, then shift offsets, instead of making a column per row.
+        const auto offsets = col->offsets_->GetData();
+        if (offsets.empty()) {
+            return;
+        }
+
+        const size_t items = offsets.back();
+        data_->Append(items == col->data_->Size() ? col->data_ : col->data_->Slice(0, items));
+        AppendOffsets(offsets);
     }
 }
 
@@ -110,6 +145,14 @@ size_t ColumnArray::Size() const {
     return offsets_->Size();
 }
 
+size_t ColumnArray::ByteSize() const {
+    return data_->ByteSize() + offsets_->ByteSize();
+}
+
+size_t ColumnArray::AllocatedBytes() const {
+    return data_->AllocatedBytes() + offsets_->AllocatedBytes();
+}
+
 void ColumnArray::Swap(Column& other) {
     auto & col = dynamic_cast<ColumnArray &>(other);
     data_.swap(col.data_);
@@ -137,6 +180,30 @@ size_t ColumnArray::GetSize(size_t n) const {
     return (n == 0) ? (*offsets_)[n] : ((*offsets_)[n] - (*offsets_)[n - 1]);
 }
 
+void ColumnArray::CheckOffsets(Span<const uint64_t> offsets, size_t values_size) {
+    uint64_t previous = 0;
+    for (const auto offset : offsets) {
+        if (offset < previous) {
+            throw ValidationError("Array offsets must be non-decreasing, got " + std::to_string(offset) + " after " + std::to_string(previous));
+        }
+        previous = offset;
+    }
+
+    if (previous != values_size) {
+        throw ValidationError("Array offsets describe " + std::to_string(previous) + " items, but there are " + std::to_string(values_size));
+    }
+}
+
+void ColumnArray::AppendOffsets(Span<const uint64_t> offsets) {
+    auto & data = offsets_->GetWritableData();
+    const uint64_t base = data.empty() ? 0 : data.back();
+
+    data.reserve(data.size() + offsets.size());
+    for (const auto offset : offsets) {
+        data.push_back(base + offset);
+    }
+}
+
 ColumnRef ColumnArray::GetData() {
     return data_;
 }
@@ -5,6 +5,7 @@
 #include "utils.h"
 
 #include <memory>
+#include <type_traits>
 
 namespace timeplus {
 
@@ -46,6 +47,25 @@ public:
         return GetAsColumn(n)->AsStrict<T>();
     }
 
+    /// Finishes a row made of all items appended to the nested column since the previous row, see ColumnArrayT::BeginRow().
+    void EndRow();
+
+    /** Appends rows given as flat nested values and offsets, the same layout as on the wire:
+     *  i-th row ends at offsets[i] in `values`, so offsets are non-decreasing and the last one is values->Size().
+     *  Throws ValidationError if offsets are malformed or `values` is not a column of array items type.
+     */
+    void AppendRows(Span<const uint64_t> offsets, ColumnRef values);
+
+    /// Same as EndRow() for many rows at once: finishes rows made of items appended to the nested column since the previous row,
+    /// i-th of them ends at offsets[i] counting from there, see AppendRows(). Throws ValidationError if offsets are malformed.
+    void EndRows(Span<const uint64_t> offsets);
+
+    /// Returns offsets of ends of all rows in the nested column.
+    Span<const uint64_t> GetOffsets() const;
+
+    /// Throws ValidationError unless `offsets` describe rows of exactly `values_size` items, as expected by AppendRows().
+    static void CheckOffsets(Span<const uint64_t> offsets, size_t values_size);
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -71,6 +91,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t, size_t) const override;
     ColumnRef CloneEmpty() const override;
@@ -89,6 +115,9 @@ protected:
     void AddOffset(size_t n);
     void Reset();
 
+    /// Appends offsets of rows whose items were just appended to the nested column.
+    void AppendOffsets(Span<const uint64_t> offsets);
+
 private:
     ColumnRef data_;
     std::shared_ptr<ColumnUInt64> offsets_;
@@ -292,6 +321,33 @@ public:
         AddOffset(counter);
     }
 
+    /** Starts a new row: items are appended directly to the returned nested column, then EndRow() finishes the row.
+     *  No temporary column is created per row:
+     *
+     *      auto& items = column.BeginRow();
+     *      items.Append(1);
+     *      items.Append(2);
+     *      column.EndRow();
+     */
+    inline NestedColumnType& BeginRow() {
+        return *typed_nested_data_;
+    }
+
+    /// Returns typed column of items of all rows.
+    inline const NestedColumnType& GetNestedColumn() const {
+        return *typed_nested_data_;
+    }
+
+    using ColumnArray::AppendRows;
+
+    /// Same as AppendRows(offsets, ColumnRef), with items given as a contiguous array, i.e. for arrays of numbers.
+    void AppendRows(Span<const uint64_t> offsets, Span<const typename ArrayValueView::ValueType> values) {
+        CheckOffsets(offsets, values.size());
+
+        details::AppendItems(*typed_nested_data_, values);
+        AppendOffsets(offsets);
+    }
+
     ColumnRef Slice(size_t begin, size_t size) const override {
         return Wrap(ColumnArray::Slice(begin, size));
     }
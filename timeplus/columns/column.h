@@ -83,7 +83,22 @@ public:
     /// Returns count of rows in the column.
     virtual size_t Size() const = 0;
 
+    /// Returns size of values of all rows as kept in memory, in bytes, e.g. for byte-based batching.
+    /// Doesn't include unused reserved capacity, lookup indexes and other auxiliary structures.
+    /// Column types that don't implement it report 0.
+    virtual size_t ByteSize() const { return 0; }
+
+    /** Returns amount of memory held by the column, in bytes: ByteSize() plus reserved capacity,
+     *  partially filled storage blocks, dictionaries' lookup indexes and such.
+     *  Memory shared with slices (copy-on-write) or adopted is counted in whole by every column referring to it,
+     *  a slice counts the whole allocation of the column it was made from (as of slicing).
+     *  Column types that don't implement it report ByteSize().
+     */
+    virtual size_t AllocatedBytes() const { return ByteSize(); }
+
     /// Makes slice of the current column.
+    /// Slice may share memory with the current column (copy-on-write) instead of copying the data,
+    /// the columns remain independent of each other though: either may be modified or destroyed, also concurrently.
     virtual ColumnRef Slice(size_t begin, size_t len) const = 0;
 
     virtual ColumnRef CloneEmpty() const = 0;
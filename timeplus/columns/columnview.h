@@ -0,0 +1,70 @@
+#pragma once
+
+#include "column.h"
+#include "date.h"
+#include "decimal.h"
+#include "numeric.h"
+#include "../base/span.h"
+
+#include <type_traits>
+
+namespace timeplus {
+
+/** Typed read-only view of column values stored as a contiguous array of T.
+ *
+ *  Column type is resolved once, when the view is created (e.g. once per block),
+ *  after that access is unchecked and doesn't involve virtual calls or shared_ptr copies,
+ *  so loops over the view compile down to plain loads:
+ *
+ *      ColumnView<int64_t> values(*block[0]);
+ *      for (const auto value : values) { ... }
+ *
+ *  Supported columns and corresponding T:
+ *    - ColumnVector<T>: T itself;
+ *    - ColumnDate: uint16_t, ColumnDate32: int32_t, ColumnDateTime: uint32_t, ColumnDateTime64: Int64 (raw values);
+ *    - ColumnDecimal: int32_t, int64_t, Int128 or Int256 depending on precision (unscaled values).
+ *
+ *  The view is valid as long as the column is alive and is not modified.
+ */
+template <typename T>
+class ColumnView : public Span<const T> {
+public:
+    /// Throws ValidationError if `column` doesn't store its values as contiguous array of T.
+    explicit ColumnView(const Column& column)
+        : Span<const T>(GetData(column))
+    {}
+
+    explicit ColumnView(const ColumnRef& column)
+        : ColumnView(*column)
+    {}
+
+private:
+    static Span<const T> GetData(const Column& column) {
+        if (auto vector = dynamic_cast<const ColumnVector<T>*>(&column)) {
+            return vector->GetData();
+        }
+
+        if constexpr (std::is_same_v<T, uint16_t>) {
+            if (auto date = dynamic_cast<const ColumnDate*>(&column))
+                return date->GetRawData();
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+            if (auto date = dynamic_cast<const ColumnDate32*>(&column))
+                return date->GetRawData();
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+            if (auto date_time = dynamic_cast<const ColumnDateTime*>(&column))
+                return date_time->GetRawData();
+        } else if constexpr (std::is_same_v<T, Int64>) {
+            if (auto date_time = dynamic_cast<const ColumnDateTime64*>(&column))
+                return date_time->GetRawData();
+        }
+
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> || std::is_same_v<T, Int128> || std::is_same_v<T, Int256>) {
+            if (auto decimal = dynamic_cast<const ColumnDecimal*>(&column))
+                return decimal->GetRawData<T>();
+        }
+
+        throw ValidationError("Can't view column of type " + column.GetType().GetName() + " as contiguous array of requested type");
+    }
+};
+
+}
@@ -1,8 +1,52 @@
 #include "date.h"
+
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 namespace timeplus {
 
+namespace {
+
+/// Bulk conversions go through buffers of that size on the stack.
+constexpr size_t CONVERSION_BLOCK = 256;
+
+constexpr size_t NANOSECOND_DIGITS = 9;
+
+int64_t Pow10(size_t power) {
+    int64_t result = 1;
+    while (power--) {
+        result *= 10;
+    }
+    return result;
+}
+
+inline int64_t FloorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+void CheckOutputSize(size_t output_size, size_t column_size) {
+    if (output_size != column_size) {
+        throw ValidationError("output has " + std::to_string(output_size) + " elements, while column has " + std::to_string(column_size) + " rows");
+    }
+}
+
+/// Makes room for `count` values at the end of `data`, lets `convert` fill them and rolls back if it throws.
+template <typename T, typename Convert>
+void AppendConverted(std::vector<T>& data, size_t count, Convert&& convert) {
+    const size_t size = data.size();
+    data.resize(size + count);
+    try {
+        convert(data.data() + size);
+    } catch (...) {
+        data.resize(size);
+        throw;
+    }
+}
+
+}
+
 ColumnDate::ColumnDate()
     : Column(Type::CreateDate())
     , data_(std::make_shared<ColumnUInt16>())
@@ -67,11 +111,19 @@ size_t ColumnDate::Size() const {
     return data_->Size();
 }
 
+size_t ColumnDate::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnDate::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnDate::Slice(size_t begin, size_t len) const {
     auto col = data_->Slice(begin, len)->As<ColumnUInt16>();
     auto result = std::make_shared<ColumnDate>();
 
-    result->data_->Append(col);
+    result->data_ = col;
 
     return result;
 }
@@ -154,11 +206,19 @@ size_t ColumnDate32::Size() const {
     return data_->Size();
 }
 
+size_t ColumnDate32::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnDate32::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnDate32::Slice(size_t begin, size_t len) const {
     auto col = data_->Slice(begin, len)->As<ColumnInt32>();
     auto result = std::make_shared<ColumnDate32>();
 
-    result->data_->Append(col);
+    result->data_ = col;
 
     return result;
 }
@@ -214,6 +274,42 @@ std::string ColumnDateTime::Timezone() const {
     return type_->As<DateTimeType>()->Timezone();
 }
 
+void ColumnDateTime::ToCivilTimes(Span<CivilTime> output, const TimeZone& time_zone) const {
+    CheckOutputSize(output.size(), Size());
+
+    const auto values = data_->GetData();
+    int64_t times[CONVERSION_BLOCK];
+    for (size_t begin = 0; begin < values.size(); begin += CONVERSION_BLOCK) {
+        const size_t count = std::min(CONVERSION_BLOCK, values.size() - begin);
+        std::copy(values.begin() + begin, values.begin() + begin + count, times);
+        time_zone.ToCivil(times, count, output.data() + begin);
+    }
+}
+
+void ColumnDateTime::ToCivilTimes(Span<CivilTime> output) const {
+    ToCivilTimes(output, *TimeZone::Get(Timezone()));
+}
+
+void ColumnDateTime::AppendCivilTimes(Span<const CivilTime> values, const TimeZone& time_zone) {
+    AppendConverted(data_->GetWritableData(), values.size(), [&] (uint32_t* out) {
+        int64_t times[CONVERSION_BLOCK];
+        for (size_t begin = 0; begin < values.size(); begin += CONVERSION_BLOCK) {
+            const size_t count = std::min(CONVERSION_BLOCK, values.size() - begin);
+            time_zone.FromCivil(values.data() + begin, count, times);
+            for (size_t i = 0; i < count; ++i) {
+                if (times[i] < 0 || times[i] > std::numeric_limits<uint32_t>::max()) {
+                    throw ValidationError("time " + std::to_string(times[i]) + " is out of range of " + GetType().GetName());
+                }
+                out[begin + i] = static_cast<uint32_t>(times[i]);
+            }
+        }
+    });
+}
+
+void ColumnDateTime::AppendCivilTimes(Span<const CivilTime> values) {
+    AppendCivilTimes(values, *TimeZone::Get(Timezone()));
+}
+
 void ColumnDateTime::Append(ColumnRef column) {
     if (auto col = column->As<ColumnDateTime>()) {
         data_->Append(col->data_);
@@ -244,6 +340,14 @@ size_t ColumnDateTime::Size() const {
     return data_->Size();
 }
 
+size_t ColumnDateTime::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnDateTime::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 void ColumnDateTime::Clear() {
     data_->Clear();
 }
@@ -252,7 +356,7 @@ ColumnRef ColumnDateTime::Slice(size_t begin, size_t len) const {
     auto col = data_->Slice(begin, len)->As<ColumnUInt32>();
     auto result = std::make_shared<ColumnDateTime>();
 
-    result->data_->Append(col);
+    result->data_ = col;
 
     return result;
 }
@@ -303,6 +407,62 @@ std::string ColumnDateTime64::Timezone() const {
     return type_->As<DateTime64Type>()->Timezone();
 }
 
+void ColumnDateTime64::ToCivilTimes(Span<CivilTime> output, const TimeZone& time_zone) const {
+    CheckOutputSize(output.size(), Size());
+
+    const int64_t scale = Pow10(precision_);
+    const auto values = GetRawData();
+    int64_t times[CONVERSION_BLOCK];
+    for (size_t begin = 0; begin < values.size(); begin += CONVERSION_BLOCK) {
+        const size_t count = std::min(CONVERSION_BLOCK, values.size() - begin);
+        for (size_t i = 0; i < count; ++i) {
+            times[i] = FloorDiv(values[begin + i], scale);
+        }
+
+        CivilTime* out = output.data() + begin;
+        time_zone.ToCivil(times, count, out);
+
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t fraction = values[begin + i] - times[i] * scale;
+            out[i].nanosecond = static_cast<uint32_t>(precision_ <= NANOSECOND_DIGITS
+                ? fraction * Pow10(NANOSECOND_DIGITS - precision_)
+                : fraction / Pow10(precision_ - NANOSECOND_DIGITS));
+        }
+    }
+}
+
+void ColumnDateTime64::ToCivilTimes(Span<CivilTime> output) const {
+    ToCivilTimes(output, *TimeZone::Get(Timezone()));
+}
+
+void ColumnDateTime64::AppendCivilTimes(Span<const CivilTime> values, const TimeZone& time_zone) {
+    const int64_t scale = Pow10(precision_);
+    const int64_t max_seconds = std::numeric_limits<int64_t>::max() / scale - 1;
+
+    AppendConverted(data_->GetWritableRawData<int64_t>(), values.size(), [&] (int64_t* out) {
+        int64_t times[CONVERSION_BLOCK];
+        for (size_t begin = 0; begin < values.size(); begin += CONVERSION_BLOCK) {
+            const size_t count = std::min(CONVERSION_BLOCK, values.size() - begin);
+            time_zone.FromCivil(values.data() + begin, count, times);
+
+            for (size_t i = 0; i < count; ++i) {
+                const int64_t nanosecond = values[begin + i].nanosecond;
+                if (nanosecond >= Pow10(NANOSECOND_DIGITS) || times[i] < -max_seconds || times[i] > max_seconds) {
+                    throw ValidationError("time " + std::to_string(times[i]) + "." + std::to_string(nanosecond)
+                        + " is out of range of " + GetType().GetName());
+                }
+                out[begin + i] = times[i] * scale + (precision_ <= NANOSECOND_DIGITS
+                    ? nanosecond / Pow10(NANOSECOND_DIGITS - precision_)
+                    : nanosecond * Pow10(precision_ - NANOSECOND_DIGITS));
+            }
+        }
+    });
+}
+
+void ColumnDateTime64::AppendCivilTimes(Span<const CivilTime> values) {
+    AppendCivilTimes(values, *TimeZone::Get(Timezone()));
+}
+
 void ColumnDateTime64::Reserve(size_t new_cap)
 {
     data_->Reserve(new_cap);
@@ -330,6 +490,14 @@ size_t ColumnDateTime64::Size() const {
     return data_->Size();
 }
 
+size_t ColumnDateTime64::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnDateTime64::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ItemView ColumnDateTime64::GetItem(size_t index) const {
     return ItemView(Type::DateTime64, data_->GetItem(index));
 }
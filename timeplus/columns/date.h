@@ -2,6 +2,7 @@
 
 #include "decimal.h"
 #include "numeric.h"
+#include "../base/time_zone.h"
 
 #include <ctime>
 
@@ -28,6 +29,9 @@ public:
     void AppendRaw(uint16_t value);
     uint16_t RawAt(size_t n) const;
 
+    /// All raw values (as with RawAt()) as contiguous read-only view.
+    inline Span<const uint16_t> GetRawData() const { return data_->GetData(); }
+
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override;
 
@@ -52,6 +56,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
@@ -85,6 +95,9 @@ public:
     void AppendRaw(int32_t value);
     int32_t RawAt(size_t n) const;
 
+    /// All raw values (as with RawAt()) as contiguous read-only view.
+    inline Span<const int32_t> GetRawData() const { return data_->GetData(); }
+
     /// Get Raw Vector Contents
     std::vector<int32_t>& GetWritableData();
 
@@ -110,6 +123,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
@@ -143,9 +162,23 @@ public:
     /// Append raw as UNIX epoch seconds in uint32
     void AppendRaw(uint32_t value);
 
+    /// All values as UNIX epoch seconds, contiguous read-only view.
+    inline Span<const uint32_t> GetRawData() const { return data_->GetData(); }
+
     /// Timezone associated with a data column.
     std::string Timezone() const;
 
+    /// Converts all values to civil time in `time_zone`, `output` must have exactly Size() elements.
+    void ToCivilTimes(Span<CivilTime> output, const TimeZone& time_zone) const;
+    /// Same as above, in the timezone of the column (UTC if it has none).
+    void ToCivilTimes(Span<CivilTime> output) const;
+
+    /// Appends civil times in `time_zone`. Throws ValidationError, leaving the column unchanged,
+    /// if any of them is out of DateTime range (1970 - 2106).
+    void AppendCivilTimes(Span<const CivilTime> values, const TimeZone& time_zone);
+    /// Same as above, in the timezone of the column (UTC if it has none).
+    void AppendCivilTimes(Span<const CivilTime> values);
+
     /// Get Raw Vector Contents
     std::vector<uint32_t>& GetWritableData();
 
@@ -171,6 +204,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
@@ -202,9 +241,24 @@ public:
 
     inline Int64 operator[](size_t n) const { return At(n); }
 
+    /// All values (as with At()) as contiguous read-only view.
+    inline Span<const Int64> GetRawData() const { return data_->GetRawData<Int64>(); }
+
     /// Timezone associated with a data column.
     std::string Timezone() const;
 
+    /// Converts all values to civil time in `time_zone`, with sub-second part in CivilTime::nanosecond.
+    /// `output` must have exactly Size() elements.
+    void ToCivilTimes(Span<CivilTime> output, const TimeZone& time_zone) const;
+    /// Same as above, in the timezone of the column (UTC if it has none).
+    void ToCivilTimes(Span<CivilTime> output) const;
+
+    /// Appends civil times in `time_zone`, sub-second part is truncated to the precision of the column.
+    /// Throws ValidationError, leaving the column unchanged, if any of them doesn't fit.
+    void AppendCivilTimes(Span<const CivilTime> values, const TimeZone& time_zone);
+    /// Same as above, in the timezone of the column (UTC if it has none).
+    void AppendCivilTimes(Span<const CivilTime> values);
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -224,6 +278,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
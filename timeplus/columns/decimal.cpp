@@ -1,69 +1,206 @@
 #include "decimal.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
 namespace
 {
 using namespace timeplus;
 
+constexpr int64_t POW10[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+    10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+    1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL,
+};
+
 template <typename T>
-inline bool getSignBit(const T & v)
-{
-    return v < static_cast<T>(0);
+T Pow10(size_t power) {
+    T result = 1;
+    while (power--) {
+        result *= T(10);
+    }
+    return result;
 }
 
-inline bool getSignBit(const Int256 & v)
-{
-   static constexpr Int256 zero {};
-   return v < zero;
+/// Bulk conversion kernels for Decimal32/64 storage, SSE2 is the baseline on x86-64.
+/// Range checks are accumulated over the whole batch instead of branching on every value.
+
+/// Values are converted in blocks of that size, so a block not suitable for the fast path is redone while still in cache.
+constexpr size_t CONVERSION_BLOCK = 1024;
+
+/// 2^51: doubles and int64 values within that magnitude are converted with MAGIC.
+constexpr double MAX_FAST_DOUBLE = 2251799813685248.0;
+constexpr uint64_t MAX_FAST_INT64 = 2251799813685248ULL;
+/// 1.5 * 2^52: adding it to a double within 2^51 leaves the value rounded to integer in the low bits of mantissa.
+constexpr double MAGIC = 6755399441055744.0;
+
+/// Stores values[i] * multiplier rounded to nearest into out[i].
+/// Returns false if any of the results is NaN or not below `limit` in magnitude, out[i] is unspecified for such values.
+bool ScaleToInt32(const double* values, size_t size, double multiplier, double limit, int32_t* out) {
+    size_t i = 0;
+    bool in_range = true;
+#if defined(__SSE2__)
+    const __m128d mul = _mm_set1_pd(multiplier);
+    const __m128d max = _mm_set1_pd(limit);
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(std::numeric_limits<int64_t>::max()));
+    __m128d out_of_range = _mm_setzero_pd();
+    for (; i + 2 <= size; i += 2) {
+        const __m128d scaled = _mm_mul_pd(_mm_loadu_pd(values + i), mul);
+        out_of_range = _mm_or_pd(out_of_range, _mm_cmpnlt_pd(_mm_and_pd(scaled, abs_mask), max));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_cvtpd_epi32(scaled));
+    }
+    in_range = _mm_movemask_pd(out_of_range) == 0;
+#endif
+    for (; i < size; ++i) {
+        const double scaled = values[i] * multiplier;
+        if (std::fabs(scaled) < limit) {
+            out[i] = static_cast<int32_t>(std::nearbyint(scaled));
+        } else {
+            in_range = false;
+        }
+    }
+    return in_range;
+}
 
+/// Same as above for int64, `limit` must not exceed MAX_FAST_DOUBLE.
+bool ScaleToInt64(const double* values, size_t size, double multiplier, double limit, int64_t* out) {
+    size_t i = 0;
+    bool in_range = true;
+#if defined(__SSE2__)
+    const __m128d mul = _mm_set1_pd(multiplier);
+    const __m128d max = _mm_set1_pd(limit);
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(std::numeric_limits<int64_t>::max()));
+    const __m128d magic = _mm_set1_pd(MAGIC);
+    __m128d out_of_range = _mm_setzero_pd();
+    for (; i + 2 <= size; i += 2) {
+        const __m128d scaled = _mm_mul_pd(_mm_loadu_pd(values + i), mul);
+        out_of_range = _mm_or_pd(out_of_range, _mm_cmpnlt_pd(_mm_and_pd(scaled, abs_mask), max));
+        const __m128i rounded = _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(scaled, magic)), _mm_castpd_si128(magic));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), rounded);
+    }
+    in_range = _mm_movemask_pd(out_of_range) == 0;
+#endif
+    for (; i < size; ++i) {
+        const double scaled = values[i] * multiplier;
+        if (std::fabs(scaled) < limit) {
+            out[i] = static_cast<int64_t>(std::nearbyint(scaled));
+        } else {
+            in_range = false;
+        }
+    }
+    return in_range;
 }
 
-inline bool addOverflow(const Int256 & l, const Int256 & r, Int256 * result)
-{
-    // Based on code from:
-    // https://wiki.sei.cmu.edu/confluence/display/c/INT32-C.+Ensure+that+operations+on+signed+integers+do+not+result+in+overflow#INT32C.Ensurethatoperationsonsignedintegersdonotresultinoverflow-CompliantSolution
-    const auto r_positive = !getSignBit(r);
+[[noreturn]] void ThrowOutOfRange(const std::string& value, const Type& type) {
+    throw ValidationError("value " + value + " is out of range of " + type.GetName());
+}
 
-    if ((r_positive && (l > (std::numeric_limits<Int256>::max() - r))) ||
-        (!r_positive && (l < (std::numeric_limits<Int256>::min() - r)))) {
-        return true;
+/// Exact conversion of integral `value` to Int128/Int256.
+template <typename T>
+T ToWideInteger(double value) {
+    if (std::fabs(value) < 9.2e18) {
+        return T(static_cast<int64_t>(value));
     }
-    *result = l + r;
 
-    return false;
+    // value = fraction * 2^exponent, where fraction has 53 significant bits.
+    int exponent = 0;
+    const double fraction = std::frexp(std::fabs(value), &exponent);
+    const T result = T(static_cast<int64_t>(std::ldexp(fraction, 53))) << (exponent - 53);
+    return value < 0 ? -result : result;
 }
 
+/// Per-value conversion for values the kernels can't handle: wide storage, or beyond 2^51.
 template <typename T>
-inline bool mulOverflow(const Int256 & l, const T & r, Int256 * result)
-{
-    // Based on code from:
-    // https://wiki.sei.cmu.edu/confluence/display/c/INT32-C.+Ensure+that+operations+on+signed+integers+do+not+result+in+overflow#INT32C.Ensurethatoperationsonsignedintegersdonotresultinoverflow-CompliantSolution.3
-    const auto l_positive = !getSignBit(l);
-    const auto r_positive = !getSignBit(r);
-
-    if (l_positive) {
-        if (r_positive) {
-            if (r != 0 && l > (std::numeric_limits<Int256>::max() / r)) {
-                return true;
-            }
+void ScaleExact(const double* values, size_t size, double multiplier, double limit, T* out, const Type& type) {
+    for (size_t i = 0; i < size; ++i) {
+        const double scaled = values[i] * multiplier;
+        if (!(std::fabs(scaled) < limit)) {
+            ThrowOutOfRange(std::to_string(values[i]), type);
+        }
+        if constexpr (std::is_integral_v<T>) {
+            out[i] = static_cast<T>(std::nearbyint(scaled));
         } else {
-            if (l != 0 && r < (std::numeric_limits<Int256>::min() / l)) {
-                return true;
-            }
+            out[i] = ToWideInteger<T>(std::nearbyint(scaled));
         }
-    } else {
-        if (r_positive) {
-            if (r != 0 && l < (std::numeric_limits<Int256>::min() / r)) {
-                return true;
+    }
+}
+
+void UnscaleInt32(const int32_t* values, size_t size, double divisor, double* out) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128d div = _mm_set1_pd(divisor);
+    for (; i + 2 <= size; i += 2) {
+        const __m128d converted = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i)));
+        _mm_storeu_pd(out + i, _mm_div_pd(converted, div));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = static_cast<double>(values[i]) / divisor;
+    }
+}
+
+void UnscaleInt64(const int64_t* values, size_t size, double divisor, double* out) {
+    for (size_t begin = 0; begin < size; begin += CONVERSION_BLOCK) {
+        const size_t end = std::min(size, begin + CONVERSION_BLOCK);
+        size_t i = begin;
+#if defined(__SSE2__)
+        // Non-zero if some value is outside of [-2^51, 2^51).
+        uint64_t out_of_range = 0;
+        for (size_t j = begin; j < end; ++j) {
+            out_of_range |= (static_cast<uint64_t>(values[j]) + MAX_FAST_INT64) >> 52;
+        }
+
+        if (out_of_range == 0) {
+            const __m128d div = _mm_set1_pd(divisor);
+            const __m128d magic = _mm_set1_pd(MAGIC);
+            for (; i + 2 <= end; i += 2) {
+                const __m128i bits = _mm_add_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), _mm_castpd_si128(magic));
+                _mm_storeu_pd(out + i, _mm_div_pd(_mm_sub_pd(_mm_castsi128_pd(bits), magic), div));
             }
-        } else {
-            if (l != 0 && (r < (std::numeric_limits<Int256>::max() / l))) {
-                return true;
+        }
+#endif
+        for (; i < end; ++i) {
+            out[i] = static_cast<double>(values[i]) / divisor;
+        }
+    }
+}
+
+/// Throws ValidationError unless all values are within (-bound, bound).
+void CheckRange(Span<const int64_t> values, int64_t bound, const Type& type) {
+    int64_t min = 0;
+    int64_t max = 0;
+    for (const auto value : values) {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    if (min <= -bound || max >= bound) {
+        for (const auto value : values) {
+            if (value <= -bound || value >= bound) {
+                ThrowOutOfRange(std::to_string(value), type);
             }
         }
     }
+}
 
-    *result = l * r;
-    return false;
+/// Makes room for `count` values at the end of `column`, lets `convert` fill them and rolls back if it throws.
+template <typename T, typename Convert>
+void AppendConverted(Column& column, size_t count, Convert&& convert) {
+    auto& data = static_cast<ColumnVector<T>&>(column).GetWritableData();
+    const size_t size = data.size();
+    data.resize(size + count);
+    try {
+        convert(data.data() + size);
+    } catch (...) {
+        data.resize(size);
+        throw;
+    }
 }
 
 }
@@ -91,23 +228,33 @@ ColumnDecimal::ColumnDecimal(TypeRef type, ColumnRef data)
 }
 
 void ColumnDecimal::Append(const Int256& value) {
-    if (data_->Type()->GetCode() == Type::Int32) {
-        assert(value >= std::numeric_limits<ColumnInt32::DataType>::min() && value <= std::numeric_limits<ColumnInt32::DataType>::max());
-        data_->As<ColumnInt32>()->Append(static_cast<ColumnInt32::DataType>(value));
-    } else if (data_->Type()->GetCode() == Type::Int64) {
-        assert(value >= std::numeric_limits<ColumnInt64::DataType>::min() && value <= std::numeric_limits<ColumnInt64::DataType>::max());
-        data_->As<ColumnInt64>()->Append(static_cast<ColumnInt64::DataType>(value));
-    } else if (data_->Type()->GetCode() == Type::Int128) {
-        assert(value >= std::numeric_limits<ColumnInt128::DataType>::min() && value <= std::numeric_limits<ColumnInt128::DataType>::max());
-        data_->As<ColumnInt128>()->Append(static_cast<ColumnInt128::DataType>(value));
-    } else {
-        assert(value >= std::numeric_limits<ColumnInt256::DataType>::min() && value <= std::numeric_limits<ColumnInt256::DataType>::max());
-        data_->As<ColumnInt256>()->Append(static_cast<ColumnInt256::DataType>(value));
+    // The type of data_ is checked already, so it is downcast statically: this is called for every value.
+    switch (data_->Type()->GetCode()) {
+        case Type::Int32:
+            assert(value >= std::numeric_limits<ColumnInt32::DataType>::min() && value <= std::numeric_limits<ColumnInt32::DataType>::max());
+            static_cast<ColumnInt32&>(*data_).Append(static_cast<ColumnInt32::DataType>(value));
+            break;
+        case Type::Int64:
+            assert(value >= std::numeric_limits<ColumnInt64::DataType>::min() && value <= std::numeric_limits<ColumnInt64::DataType>::max());
+            static_cast<ColumnInt64&>(*data_).Append(static_cast<ColumnInt64::DataType>(value));
+            break;
+        case Type::Int128:
+            assert(value >= std::numeric_limits<ColumnInt128::DataType>::min() && value <= std::numeric_limits<ColumnInt128::DataType>::max());
+            static_cast<ColumnInt128&>(*data_).Append(static_cast<ColumnInt128::DataType>(value));
+            break;
+        default:
+            static_cast<ColumnInt256&>(*data_).Append(value);
+            break;
     }
 }
 
 void ColumnDecimal::Append(const std::string& value) {
-    Int256 int_value = 0;
+    // Digits are accumulated in 64-bit chunks, which are folded into the 256-bit magnitude only once full:
+    // Decimal32/64 values (up to 19 digits) never take wide arithmetic.
+    UInt256 magnitude = 0;
+    uint64_t chunk = 0;
+    size_t chunk_digits = 0;
+    bool is_wide = false;
     auto c = value.begin();
     auto end = value.end();
     bool sign = true;
@@ -117,9 +264,26 @@ void ColumnDecimal::Append(const std::string& value) {
 
     size_t zeros = 0;
 
-    auto scale = type_->As<DecimalType>()->GetScale();
-    auto precision = type_->As<DecimalType>()->GetPrecision();
-    auto name = type_->As<DecimalType>()->GetName();
+    const auto type = type_->As<DecimalType>();
+    const auto scale = type->GetScale();
+    const auto precision = type->GetPrecision();
+
+    const auto flush_chunk = [&] {
+        if (wide::details::multiply_add(magnitude, wide::details::POW10[chunk_digits], chunk) != 0) {
+            throw AssertionError("value is too big for " + GetType().GetName());
+        }
+        chunk = 0;
+        chunk_digits = 0;
+        is_wide = true;
+    };
+
+    const auto append_digit = [&] (int digit) {
+        if (chunk_digits == wide::details::CHUNK_DIGITS) {
+            flush_chunk();
+        }
+        chunk = chunk * 10 + static_cast<uint64_t>(digit);
+        ++chunk_digits;
+    };
 
     while (c != end) {
         if (*c == '-') {
@@ -139,13 +303,10 @@ void ColumnDecimal::Append(const std::string& value) {
             has_dot = true;
         } else if (*c >= '0' && *c <= '9') {
             if (int_part_length > precision - scale) {
-                throw std::runtime_error("value is too big for " + std::string(name));
+                throw std::runtime_error("value is too big for " + GetType().GetName());
             }
 
-            if (mulOverflow(int_value, 10, &int_value) ||
-                addOverflow(int_value, *c - '0', &int_value)) {
-                throw AssertionError("value is too big for " + std::string(name));
-            }
+            append_digit(*c - '0');
 
             if (!has_dot) {
                 int_part_length++;
@@ -161,25 +322,191 @@ void ColumnDecimal::Append(const std::string& value) {
     }
 
     while (zeros) {
-        if (mulOverflow(int_value, 10, &int_value)) {
-            throw AssertionError("value is too big for " + std::string(name));
-        }
+        append_digit(0);
         --zeros;
     }
 
+    Int256 int_value = 0;
+    if (is_wide) {
+        flush_chunk();
+        if (magnitude > UInt256(std::numeric_limits<Int256>::max())) {
+            throw AssertionError("value is too big for " + GetType().GetName());
+        }
+        int_value = Int256(magnitude);
+    } else {
+        int_value = chunk;
+    }
+
     Append(sign ? int_value : -int_value);
 }
 
 Int256 ColumnDecimal::At(size_t i) const {
     switch (data_->Type()->GetCode()) {
         case Type::Int32:
-            return static_cast<Int256>(data_->As<ColumnInt32>()->At(i));
+            return static_cast<Int256>(static_cast<const ColumnInt32&>(*data_).At(i));
         case Type::Int64:
-            return static_cast<Int256>(data_->As<ColumnInt64>()->At(i));
+            return static_cast<Int256>(static_cast<const ColumnInt64&>(*data_).At(i));
         case Type::Int128:
-            return static_cast<Int256>(data_->As<ColumnInt128>()->At(i));
+            return static_cast<Int256>(static_cast<const ColumnInt128&>(*data_).At(i));
         case Type::Int256:
-            return data_->As<ColumnInt256>()->At(i);
+            return static_cast<const ColumnInt256&>(*data_).At(i);
+        default:
+            throw ValidationError("Invalid data_ column type in ColumnDecimal");
+    }
+}
+
+void ColumnDecimal::AppendDoubles(Span<const double> values) {
+    const auto type = type_->As<DecimalType>();
+    const double multiplier = std::pow(10.0, static_cast<double>(type->GetScale()));
+    // Values rounded up to 10^precision don't fit.
+    const double limit = std::pow(10.0, static_cast<double>(type->GetPrecision())) - 0.5;
+
+    switch (data_->Type()->GetCode()) {
+        case Type::Int32:
+            AppendConverted<int32_t>(*data_, values.size(), [&] (int32_t* out) {
+                if (!ScaleToInt32(values.data(), values.size(), multiplier, limit, out)) {
+                    ScaleExact(values.data(), values.size(), multiplier, limit, out, GetType());
+                }
+            });
+            break;
+        case Type::Int64:
+            AppendConverted<int64_t>(*data_, values.size(), [&] (int64_t* out) {
+                const double fast_limit = std::min(limit, MAX_FAST_DOUBLE);
+                for (size_t begin = 0; begin < values.size(); begin += CONVERSION_BLOCK) {
+                    const size_t size = std::min(CONVERSION_BLOCK, values.size() - begin);
+                    if (!ScaleToInt64(values.data() + begin, size, multiplier, fast_limit, out + begin)) {
+                        ScaleExact(values.data() + begin, size, multiplier, limit, out + begin, GetType());
+                    }
+                }
+            });
+            break;
+        case Type::Int128:
+            AppendConverted<Int128>(*data_, values.size(), [&] (Int128* out) {
+                ScaleExact(values.data(), values.size(), multiplier, limit, out, GetType());
+            });
+            break;
+        case Type::Int256:
+            AppendConverted<Int256>(*data_, values.size(), [&] (Int256* out) {
+                ScaleExact(values.data(), values.size(), multiplier, limit, out, GetType());
+            });
+            break;
+        default:
+            throw ValidationError("Invalid data_ column type in ColumnDecimal");
+    }
+}
+
+void ColumnDecimal::AppendIntegers(Span<const int64_t> values) {
+    const auto type = type_->As<DecimalType>();
+    const size_t scale = type->GetScale();
+    const size_t integer_digits = type->GetPrecision() - scale;
+
+    // Checked once for the whole batch, so products below can't overflow.
+    if (integer_digits < std::size(POW10)) {
+        CheckRange(values, POW10[integer_digits], GetType());
+    }
+
+    switch (data_->Type()->GetCode()) {
+        case Type::Int32:
+            AppendConverted<int32_t>(*data_, values.size(), [&] (int32_t* out) {
+                const auto multiplier = static_cast<int32_t>(POW10[scale]);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    out[i] = static_cast<int32_t>(values[i]) * multiplier;
+                }
+            });
+            break;
+        case Type::Int64:
+            AppendConverted<int64_t>(*data_, values.size(), [&] (int64_t* out) {
+                const auto multiplier = POW10[scale];
+                for (size_t i = 0; i < values.size(); ++i) {
+                    out[i] = values[i] * multiplier;
+                }
+            });
+            break;
+        case Type::Int128:
+            AppendConverted<Int128>(*data_, values.size(), [&] (Int128* out) {
+                const auto multiplier = Pow10<Int128>(scale);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    out[i] = Int128(values[i]) * multiplier;
+                }
+            });
+            break;
+        case Type::Int256:
+            AppendConverted<Int256>(*data_, values.size(), [&] (Int256* out) {
+                const auto multiplier = Pow10<Int256>(scale);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    out[i] = Int256(values[i]) * multiplier;
+                }
+            });
+            break;
+        default:
+            throw ValidationError("Invalid data_ column type in ColumnDecimal");
+    }
+}
+
+void ColumnDecimal::AppendUnscaled(Span<const int64_t> values) {
+    const size_t precision = GetPrecision();
+    if (precision < std::size(POW10)) {
+        CheckRange(values, POW10[precision], GetType());
+    }
+
+    switch (data_->Type()->GetCode()) {
+        case Type::Int32:
+            AppendConverted<int32_t>(*data_, values.size(), [&] (int32_t* out) {
+                for (size_t i = 0; i < values.size(); ++i) {
+                    out[i] = static_cast<int32_t>(values[i]);
+                }
+            });
+            break;
+        case Type::Int64:
+            static_cast<ColumnInt64&>(*data_).AppendRange(values.data(), values.size());
+            break;
+        case Type::Int128:
+            AppendConverted<Int128>(*data_, values.size(), [&] (Int128* out) {
+                std::copy(values.begin(), values.end(), out);
+            });
+            break;
+        case Type::Int256:
+            AppendConverted<Int256>(*data_, values.size(), [&] (Int256* out) {
+                std::copy(values.begin(), values.end(), out);
+            });
+            break;
+        default:
+            throw ValidationError("Invalid data_ column type in ColumnDecimal");
+    }
+}
+
+void ColumnDecimal::ToDoubles(Span<double> output) const {
+    if (output.size() != Size()) {
+        throw ValidationError("output has " + std::to_string(output.size()) + " elements, while column has " + std::to_string(Size()) + " rows");
+    }
+
+    const double divisor = std::pow(10.0, static_cast<double>(GetScale()));
+
+    switch (data_->Type()->GetCode()) {
+        case Type::Int32: {
+            const auto values = static_cast<const ColumnInt32&>(*data_).GetData();
+            UnscaleInt32(values.data(), values.size(), divisor, output.data());
+            break;
+        }
+        case Type::Int64: {
+            const auto values = static_cast<const ColumnInt64&>(*data_).GetData();
+            UnscaleInt64(values.data(), values.size(), divisor, output.data());
+            break;
+        }
+        case Type::Int128: {
+            const auto values = static_cast<const ColumnInt128&>(*data_).GetData();
+            for (size_t i = 0; i < values.size(); ++i) {
+                output[i] = static_cast<double>(values[i]) / divisor;
+            }
+            break;
+        }
+        case Type::Int256: {
+            const auto values = static_cast<const ColumnInt256&>(*data_).GetData();
+            for (size_t i = 0; i < values.size(); ++i) {
+                output[i] = static_cast<double>(values[i]) / divisor;
+            }
+            break;
+        }
         default:
             throw ValidationError("Invalid data_ column type in ColumnDecimal");
     }
@@ -211,6 +538,14 @@ size_t ColumnDecimal::Size() const {
     return data_->Size();
 }
 
+size_t ColumnDecimal::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnDecimal::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnDecimal::Slice(size_t begin, size_t len) const {
     // coundn't use std::make_shared since this c-tor is private
     return ColumnRef{new ColumnDecimal(type_, data_->Slice(begin, len))};
@@ -20,6 +20,27 @@ public:
     Int256 At(size_t i) const;
     inline auto operator[](size_t i) const { return At(i); }
 
+    /** Bulk conversions, i.e. for prices of a market data feed.
+     *
+     *  All values are checked against the precision of the column before the column is modified:
+     *  if any of them doesn't fit, ValidationError is thrown and the column is left unchanged.
+     *  Decimal32 and Decimal64 columns are converted with SIMD kernels.
+     */
+
+    /// Appends `values` multiplied by 10^scale and rounded to the nearest integer (ties to even),
+    /// i.e. 1.25 is appended to Decimal(10, 2) as 125. NaN and infinities are rejected.
+    void AppendDoubles(Span<const double> values);
+
+    /// Appends integer `values` multiplied by 10^scale, i.e. 42 is appended to Decimal(10, 2) as 4200 (42.00).
+    void AppendIntegers(Span<const int64_t> values);
+
+    /// Appends already scaled `values` as is, i.e. 4200 is appended to Decimal(10, 2) as 42.00.
+    void AppendUnscaled(Span<const int64_t> values);
+
+    /// Stores all values divided by 10^scale to `output`, which must have exactly Size() elements.
+    /// The result is the nearest double to the exact value as long as unscaled value is within 2^53.
+    void ToDoubles(Span<double> output) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -28,6 +49,12 @@ public:
     void SaveBody(OutputStream* output) override;
     void Clear() override;
     size_t Size() const override;
+
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
     void Swap(Column& other) override;
@@ -36,6 +63,29 @@ public:
     size_t GetScale() const;
     size_t GetPrecision() const;
 
+    /** Unscaled values as contiguous read-only view.
+     *
+     *  T is the storage type, which depends on precision: int32_t (up to 9), int64_t (up to 18),
+     *  Int128 (up to 38) or Int256; ValidationError is thrown if T doesn't match.
+     */
+    template <typename T>
+    inline Span<const T> GetRawData() const {
+        if (auto data = dynamic_cast<const ColumnVector<T>*>(data_.get())) {
+            return data->GetData();
+        }
+        throw ValidationError("Requested type doesn't match storage type " + data_->GetType().GetName() + " of " + GetType().GetName());
+    }
+
+    /// Unscaled values for modification, T is the storage type as with GetRawData().
+    /// Values written directly are not checked against the precision.
+    template <typename T>
+    inline std::vector<T>& GetWritableRawData() {
+        if (auto data = dynamic_cast<ColumnVector<T>*>(data_.get())) {
+            return data->GetWritableData();
+        }
+        throw ValidationError("Requested type doesn't match storage type " + data_->GetType().GetName() + " of " + GetType().GetName());
+    }
+
 private:
     /// Depending on a precision it can be one of:
     ///  - ColumnInt32
@@ -1,4 +1,5 @@
 #include "enum.h"
+#include "string.h"
 #include "utils.h"
 
 #include "../base/input.h"
@@ -27,19 +28,56 @@ ColumnEnum<T>::ColumnEnum(TypeRef type, std::vector<T>&& data)
 {
 }
 
+namespace {
+
+void CheckEnumValue(const EnumType& type, int16_t value) {
+    if (!type.HasEnumValue(value)) {
+        throw ValidationError("Enum type doesn't have value " + std::to_string(value));
+    }
+}
+
+template <typename T, typename GetName>
+void AppendEnumNames(const EnumType& type, std::vector<T>& data, size_t count, GetName && get_name) {
+    const auto initial_size = data.size();
+    data.resize(initial_size + count);
+
+    T* output = data.data() + initial_size;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string_view name = get_name(i);
+        int16_t value;
+        if (!type.FindEnumValue(name, value)) {
+            data.resize(initial_size);
+            throw ValidationError("Enum type doesn't have name '" + std::string(name) + "'");
+        }
+        output[i] = static_cast<T>(value);
+    }
+}
+
+}
+
 template <typename T>
 void ColumnEnum<T>::Append(const T& value, bool checkValue) {
     if  (checkValue) {
-        // TODO: type_->HasEnumValue(value), "Enum type doesn't have value " + std::to_string(value);
+        CheckEnumValue(*type_->As<EnumType>(), value);
     }
     data_.push_back(value);
 }
 
 template <typename T>
-void ColumnEnum<T>::Append(const std::string& name) {
+void ColumnEnum<T>::Append(std::string_view name) {
     data_.push_back(static_cast<T>(type_->As<EnumType>()->GetEnumValue(name)));
 }
 
+template <typename T>
+void ColumnEnum<T>::AppendNames(Span<const std::string_view> names) {
+    AppendEnumNames(*type_->As<EnumType>(), data_, names.size(), [&names](size_t i) { return names[i]; });
+}
+
+template <typename T>
+void ColumnEnum<T>::AppendNames(const ColumnString& names) {
+    AppendEnumNames(*type_->As<EnumType>(), data_, names.Size(), [&names](size_t i) { return names[i]; });
+}
+
 template <typename T>
 void ColumnEnum<T>::Clear() {
     data_.clear();
@@ -55,16 +93,24 @@ std::string_view ColumnEnum<T>::NameAt(size_t n) const {
     return type_->As<EnumType>()->GetEnumName(data_.at(n));
 }
 
+template <typename T>
+void ColumnEnum<T>::ToNames(ColumnString& output) const {
+    const auto& type = *type_->As<EnumType>();
+    for (const auto value : data_) {
+        output.Append(type.GetEnumName(value));
+    }
+}
+
 template <typename T>
 void ColumnEnum<T>::SetAt(size_t n, const T& value, bool checkValue) {
     if (checkValue) {
-        // TODO: type_->HasEnumValue(value), "Enum type doesn't have value " + std::to_string(value);
+        CheckEnumValue(*type_->As<EnumType>(), value);
     }
     data_.at(n) = value;
 }
 
 template <typename T>
-void ColumnEnum<T>::SetNameAt(size_t n, const std::string& name) {
+void ColumnEnum<T>::SetNameAt(size_t n, std::string_view name) {
     data_.at(n) = static_cast<T>(type_->As<EnumType>()->GetEnumValue(name));
 }
 
@@ -96,6 +142,16 @@ size_t ColumnEnum<T>::Size() const {
     return data_.size();
 }
 
+template <typename T>
+size_t ColumnEnum<T>::ByteSize() const {
+    return data_.size() * sizeof(T);
+}
+
+template <typename T>
+size_t ColumnEnum<T>::AllocatedBytes() const {
+    return data_.capacity() * sizeof(T);
+}
+
 template <typename T>
 ColumnRef ColumnEnum<T>::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnEnum<T>>(type_, SliceVector(data_, begin, len));
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
+
+#include <string_view>
 
 namespace timeplus {
 
+class ColumnString;
 
 template <typename T>
 class ColumnEnum : public Column {
@@ -15,8 +19,14 @@ public:
     ColumnEnum(TypeRef type, std::vector<T>&& data);
 
     /// Appends one element to the end of column.
+    /// With `checkValue`, throws ValidationError if the enum type doesn't have such value.
     void Append(const T& value, bool checkValue = false);
-    void Append(const std::string& name);
+    void Append(std::string_view name);
+
+    /// Appends elements by names, e.g. from a String column.
+    /// Throws ValidationError, leaving the column unchanged, if any of the names is not in the enum type.
+    void AppendNames(Span<const std::string_view> names);
+    void AppendNames(const ColumnString& names);
 
     /// Returns element at given row number.
     const T& At(size_t n) const;
@@ -25,9 +35,12 @@ public:
     /// Returns element at given row number.
     inline const T& operator[] (size_t n) const { return At(n); }
 
+    /// Appends names of all elements to `output`.
+    void ToNames(ColumnString& output) const;
+
     /// Set element at given row number.
     void SetAt(size_t n, const T& value, bool checkValue = false);
-    void SetNameAt(size_t n, const std::string& name);
+    void SetNameAt(size_t n, std::string_view name);
 
 public:
     /// Increase the capacity of the column for large block insertion.
@@ -48,6 +61,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
@@ -43,7 +43,7 @@ const auto& GetASTChildElement(const TypeAst & ast, int position) {
     return ast.elements[static_cast<size_t>(position)];
 }
 
-static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
+static ColumnRef CreateTerminalColumn(const TypeAst& ast, CreateColumnByTypeSettings settings) {
     switch (ast.code) {
     case Type::Void:
         return std::make_shared<ColumnNothing>();
@@ -91,6 +91,9 @@ static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
         return std::make_shared<ColumnDecimal>(76, GetASTChildElement(ast, 0).value);
 
     case Type::String:
+        if (settings.string_compact_layout) {
+            return std::make_shared<ColumnString>(ColumnString::Layout::Compact);
+        }
         return std::make_shared<ColumnString>();
     case Type::FixedString:
         return std::make_shared<ColumnFixedString>(GetASTChildElement(ast, 0).value);
@@ -156,7 +159,7 @@ static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSetti
         }
 
         case TypeAst::Terminal: {
-            return CreateTerminalColumn(ast);
+            return CreateTerminalColumn(ast, settings);
         }
 
         case TypeAst::Tuple: {
@@ -235,7 +238,7 @@ static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSetti
             }
         }
         case TypeAst::SimpleAggregateFunction: {
-            return CreateTerminalColumn(GetASTChildElement(ast, -1));
+            return CreateTerminalColumn(GetASTChildElement(ast, -1), settings);
         }
 
         case TypeAst::Map: {
@@ -7,6 +7,8 @@ namespace timeplus {
 struct CreateColumnByTypeSettings
 {
     bool low_cardinality_as_wrapped_column = false;
+    /// Create String columns with ColumnString::Layout::Compact (offsets + contiguous chars).
+    bool string_compact_layout = false;
 };
 
 ColumnRef CreateColumnByType(const std::string& type_name, CreateColumnByTypeSettings settings = {});
@@ -66,6 +66,35 @@ void ColumnGeo<NestedColumnType, type_code>::Append(ColumnRef column) {
     }
 }
 
+template <typename NestedColumnType, Type::Code type_code>
+void ColumnGeo<NestedColumnType, type_code>::AppendFlat(
+    Span<const double> x, Span<const double> y, [[maybe_unused]] const std::array<Span<const uint64_t>, DEPTH>& offsets) {
+    if (x.size() != y.size()) {
+        throw ValidationError("Geo coordinates count mismatch: " + std::to_string(x.size()) + " x and " + std::to_string(y.size()) + " y");
+    }
+
+    // Check all levels before appending anything, from rings up to rows.
+    size_t items = x.size();
+    for (size_t level = DEPTH; level-- > 0;) {
+        ColumnArray::CheckOffsets(offsets[level], items);
+        items = offsets[level].size();
+    }
+
+    AppendFlatUnchecked(x, y, offsets.data());
+}
+
+template <typename NestedColumnType, Type::Code type_code>
+void ColumnGeo<NestedColumnType, type_code>::AppendFlatUnchecked(
+    Span<const double> x, Span<const double> y, [[maybe_unused]] const Span<const uint64_t>* offsets) {
+    if constexpr (DEPTH == 0) {
+        data_->template GetColumn<0>().AppendRange(x.data(), x.size());
+        data_->template GetColumn<1>().AppendRange(y.data(), y.size());
+    } else {
+        data_->BeginRow().AppendFlatUnchecked(x, y, offsets + 1);
+        data_->EndRows(offsets[0]);
+    }
+}
+
 template <typename NestedColumnType, Type::Code type_code>
 bool ColumnGeo<NestedColumnType, type_code>::LoadBody(InputStream* input, size_t rows) {
     return data_->LoadBody(input, rows);
@@ -81,6 +110,16 @@ size_t ColumnGeo<NestedColumnType, type_code>::Size() const {
     return data_->Size();
 }
 
+template <typename NestedColumnType, Type::Code type_code>
+size_t ColumnGeo<NestedColumnType, type_code>::ByteSize() const {
+    return data_->ByteSize();
+}
+
+template <typename NestedColumnType, Type::Code type_code>
+size_t ColumnGeo<NestedColumnType, type_code>::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 template <typename NestedColumnType, Type::Code type_code>
 ColumnRef ColumnGeo<NestedColumnType, type_code>::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnGeo>(data_->Slice(begin, len));
@@ -5,13 +5,33 @@
 #include "numeric.h"
 #include "tuple.h"
 
+#include <array>
+#include <tuple>
+#include <utility>
+
 namespace timeplus {
 
+/// Read-only view of coordinates of consecutive points, i.e. of a ring, pointing directly into column data.
+/// Points are stored as two separate arrays of coordinates (the same way they are sent to the server), hence two spans.
+struct GeoPointsView {
+    Span<const double> x;
+    Span<const double> y;
+
+    inline size_t size() const { return x.size(); }
+
+    inline std::tuple<double, double> operator[](size_t index) const { return {x[index], y[index]}; }
+};
+
 template <typename NestedColumnType, Type::Code type_code>
 class ColumnGeo : public Column {
 public:
     using ValueType = typename NestedColumnType::ValueType;
 
+    /// Levels of nesting of arrays: 0 for Point, 1 for Ring, 2 for Polygon, 3 for MultiPolygon.
+    static constexpr size_t DEPTH = type_code == Type::Code::Point ? 0
+        : type_code == Type::Code::Ring ? 1
+        : type_code == Type::Code::Polygon ? 2 : 3;
+
     ColumnGeo();
 
     explicit ColumnGeo(ColumnRef data);
@@ -28,6 +48,61 @@ public:
     /// Returns element at given row number.
     inline const ValueType operator[](size_t n) const { return At(n); }
 
+    /** Appends rows given as flat buffers, without building any nested values:
+     *  coordinates of all points back to back in `x` and `y`, and offsets of ends for every level of nesting,
+     *  as in ColumnArray::AppendRows(). `offsets[0]` are ends of rows in items of the next level
+     *  (points of Ring, rings of Polygon, polygons of MultiPolygon), the last ones are ends of rings in points.
+     *
+     *      // Two polygons: a square, and a triangle with a triangular hole.
+     *      polygons.AppendFlat(x, y, {std::vector<uint64_t>{1, 3}, std::vector<uint64_t>{5, 9, 13}});
+     *
+     *  Throws ValidationError if offsets don't match each other or the count of points, the column is unchanged then.
+     */
+    void AppendFlat(Span<const double> x, Span<const double> y, const std::array<Span<const uint64_t>, DEPTH>& offsets = {});
+
+    /// Returns coordinates of points of all rows.
+    GeoPointsView GetPoints() const {
+        if constexpr (DEPTH == 0) {
+            return {data_->template GetColumn<0>().GetData(), data_->template GetColumn<1>().GetData()};
+        } else {
+            return data_->GetNestedColumn().GetPoints();
+        }
+    }
+
+    /// Returns count of rings of all rows.
+    template <size_t depth = DEPTH>
+    size_t RingCount() const {
+        static_assert(depth > 0, "Point column has no rings");
+        return RingsBefore(Size());
+    }
+
+    /// Returns points of ring with given index, rings of all rows are counted in order, see GetRowRings().
+    template <size_t depth = DEPTH>
+    GeoPointsView GetRing(size_t ring) const {
+        static_assert(depth > 0, "Point column has no rings");
+        if constexpr (DEPTH == 1) {
+            if (ring >= Size())
+                throw ValidationError("Ring index out of bounds: " + std::to_string(ring) + ", max is " + std::to_string(Size()));
+
+            const auto offsets = data_->GetOffsets();
+            const size_t begin = ring == 0 ? 0 : offsets[ring - 1];
+            const auto points = GetPoints();
+            return {points.x.subspan(begin, offsets[ring] - begin), points.y.subspan(begin, offsets[ring] - begin)};
+        } else {
+            return data_->GetNestedColumn().GetRing(ring);
+        }
+    }
+
+    /// Returns index of the first ring of given row and index past its last ring, for GetRing().
+    template <size_t depth = DEPTH>
+    std::pair<size_t, size_t> GetRowRings(size_t n) const {
+        static_assert(depth > 0, "Point column has no rings");
+        if (n >= Size())
+            throw ValidationError("Row index out of bounds: " + std::to_string(n) + ", max is " + std::to_string(Size()));
+
+        return {RingsBefore(n), RingsBefore(n + 1)};
+    }
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -47,11 +122,32 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
     void Swap(Column& other) override;
 
+private:
+    template <typename, Type::Code> friend class ColumnGeo;
+
+    /// Same as AppendFlat(), for `x`, `y` and `offsets` already checked.
+    void AppendFlatUnchecked(Span<const double> x, Span<const double> y, const Span<const uint64_t>* offsets);
+
+    /// Returns count of rings in rows before given one.
+    size_t RingsBefore(size_t row) const {
+        if constexpr (DEPTH <= 1) {
+            return row;
+        } else {
+            return row == 0 ? 0 : data_->GetNestedColumn().RingsBefore(data_->GetOffsets()[row - 1]);
+        }
+    }
+
 private:
     std::shared_ptr<NestedColumnType> data_;
 };
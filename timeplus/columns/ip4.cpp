@@ -96,6 +96,14 @@ size_t ColumnIPv4::Size() const {
     return data_->Size();
 }
 
+size_t ColumnIPv4::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnIPv4::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnIPv4::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnIPv4>(data_->Slice(begin, len));
 }
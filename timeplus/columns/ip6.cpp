@@ -2,12 +2,215 @@
 #include "../base/socket.h" // for IPv6 platform-specific stuff
 #include "../exceptions.h"
 
+#include <cstring>
 #include <stdexcept>
 
 namespace timeplus {
 
 static_assert(sizeof(struct in6_addr) == 16, "sizeof in6_addr should be 16 bytes");
 
+namespace {
+
+constexpr size_t IPV6_SIZE = 16;
+/// "ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255"
+constexpr size_t IPV6_MAX_TEXT_SIZE = 45;
+
+inline int HexDigitValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/// Dotted decimal IPv4 address, as accepted by inet_pton: no leading zeros, no empty octets.
+bool ParseIPv4(std::string_view text, uint8_t* output) {
+    size_t octets = 0;
+    size_t i = 0;
+    while (octets < 4) {
+        if (i == text.size() || text[i] < '0' || text[i] > '9')
+            return false;
+
+        unsigned value = 0;
+        const size_t begin = i;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            if (i != begin && value == 0)
+                return false;
+            value = value * 10 + static_cast<unsigned>(text[i] - '0');
+            if (value > 255)
+                return false;
+        }
+        output[octets++] = static_cast<uint8_t>(value);
+
+        if (octets < 4) {
+            if (i == text.size() || text[i] != '.')
+                return false;
+            ++i;
+        }
+    }
+    return i == text.size();
+}
+
+/// Parses text the same way as inet_pton(AF_INET6, ...) does, without requiring it to be null-terminated.
+bool ParseIPv6(std::string_view text, uint8_t* output) {
+    uint8_t bytes[IPV6_SIZE] = {};
+    size_t size = 0;
+    // Position of "::" in bytes, if any.
+    size_t gap = IPV6_SIZE + 1;
+
+    size_t i = 0;
+    if (!text.empty() && text[0] == ':') {
+        // Leading "::", the second colon is handled in the loop.
+        if (text.size() < 2 || text[1] != ':')
+            return false;
+        i = 1;
+    }
+
+    size_t group_begin = i;
+    unsigned value = 0;
+    size_t digits = 0;
+    while (i < text.size()) {
+        const char c = text[i++];
+
+        const int digit = HexDigitValue(c);
+        if (digit >= 0) {
+            if (++digits > 4)
+                return false;
+            value = value << 4 | static_cast<unsigned>(digit);
+            continue;
+        }
+
+        if (c == ':') {
+            group_begin = i;
+            if (digits == 0) {
+                if (gap <= IPV6_SIZE)
+                    return false;
+                gap = size;
+                continue;
+            }
+            if (i == text.size() || size + 2 > IPV6_SIZE)
+                return false;
+            bytes[size++] = static_cast<uint8_t>(value >> 8);
+            bytes[size++] = static_cast<uint8_t>(value);
+            value = 0;
+            digits = 0;
+            continue;
+        }
+
+        // Trailing IPv4 address, e.g. "::ffff:1.2.3.4".
+        if (c == '.' && size + 4 <= IPV6_SIZE && ParseIPv4(text.substr(group_begin), bytes + size)) {
+            size += 4;
+            digits = 0;
+            break;
+        }
+
+        return false;
+    }
+
+    if (digits != 0) {
+        if (size + 2 > IPV6_SIZE)
+            return false;
+        bytes[size++] = static_cast<uint8_t>(value >> 8);
+        bytes[size++] = static_cast<uint8_t>(value);
+    }
+
+    if (gap <= IPV6_SIZE) {
+        // "::" must stand for at least one group of zeros.
+        if (size == IPV6_SIZE)
+            return false;
+        const size_t tail = size - gap;
+        std::memmove(bytes + IPV6_SIZE - tail, bytes + gap, tail);
+        std::memset(bytes + gap, 0, IPV6_SIZE - size);
+        size = IPV6_SIZE;
+    }
+
+    if (size != IPV6_SIZE)
+        return false;
+
+    std::memcpy(output, bytes, IPV6_SIZE);
+    return true;
+}
+
+char* FormatDecimal(unsigned value, char* output) {
+    if (value >= 100)
+        *output++ = static_cast<char>('0' + value / 100);
+    if (value >= 10)
+        *output++ = static_cast<char>('0' + value / 10 % 10);
+    *output++ = static_cast<char>('0' + value % 10);
+    return output;
+}
+
+/// Formats address the same way as inet_ntop(AF_INET6, ...) does: the longest run of zero groups
+/// (the first one of equal ones, at least two groups long) is replaced with "::",
+/// IPv4-mapped and IPv4-compatible addresses end with dotted decimal IPv4 address.
+/// Returns number of characters written, at most IPV6_MAX_TEXT_SIZE.
+size_t FormatIPv6(const uint8_t* bytes, char* output) {
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    unsigned groups[8];
+    for (size_t i = 0; i < 8; ++i) {
+        groups[i] = static_cast<unsigned>(bytes[i * 2]) << 8 | bytes[i * 2 + 1];
+    }
+
+    size_t best_begin = 0, best_size = 0;
+    for (size_t i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            ++i;
+            continue;
+        }
+        const size_t begin = i;
+        while (i < 8 && groups[i] == 0) {
+            ++i;
+        }
+        if (i - begin > best_size) {
+            best_begin = begin;
+            best_size = i - begin;
+        }
+    }
+    if (best_size < 2) {
+        best_size = 0;
+    }
+
+    char* const begin = output;
+    for (size_t i = 0; i < 8; ++i) {
+        if (best_size != 0 && i >= best_begin && i < best_begin + best_size) {
+            if (i == best_begin)
+                *output++ = ':';
+            continue;
+        }
+        if (i != 0)
+            *output++ = ':';
+
+        if (i == 6 && best_size != 0 && best_begin == 0 && (best_size == 6 || (best_size == 5 && groups[5] == 0xffff))) {
+            for (size_t j = 12; j < IPV6_SIZE; ++j) {
+                output = FormatDecimal(bytes[j], output);
+                if (j + 1 != IPV6_SIZE)
+                    *output++ = '.';
+            }
+            break;
+        }
+
+        // Hex digits without leading zeros.
+        bool started = false;
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            const unsigned digit = groups[i] >> shift & 0xf;
+            if (digit != 0 || started || shift == 0) {
+                *output++ = HEX_DIGITS[digit];
+                started = true;
+            }
+        }
+    }
+    if (best_size != 0 && best_begin + best_size == 8) {
+        *output++ = ':';
+    }
+
+    return static_cast<size_t>(output - begin);
+}
+
+}
+
 ColumnIPv6::ColumnIPv6()
     : Column(Type::CreateIPv6())
     , data_(std::make_shared<ColumnFixedString>(16))
@@ -24,12 +227,34 @@ ColumnIPv6::ColumnIPv6(ColumnRef data)
 
 void ColumnIPv6::Append(const std::string_view& str) {
     unsigned char buf[16];
-    if (inet_pton(AF_INET6, str.data(), buf) != 1) {
+    if (!ParseIPv6(str, buf)) {
         throw ValidationError("invalid IPv6 format, ip: " + std::string(str));
     }
     data_->Append(std::string_view((const char*)buf, 16));
 }
 
+void ColumnIPv6::AppendStrings(Span<const std::string_view> values) {
+    auto & data = data_->GetWritableRawData();
+    const auto initial_size = data.size();
+    data.resize(initial_size + values.size() * IPV6_SIZE);
+
+    auto output = reinterpret_cast<uint8_t*>(&data[initial_size]);
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!ParseIPv6(values[i], output + i * IPV6_SIZE)) {
+            data.resize(initial_size);
+            throw ValidationError("invalid IPv6 format, ip: " + std::string(values[i]));
+        }
+    }
+}
+
+void ColumnIPv6::ToStrings(ColumnString& output) const {
+    char text[IPV6_MAX_TEXT_SIZE];
+    for (size_t i = 0; i < Size(); ++i) {
+        const auto bytes = reinterpret_cast<const uint8_t*>(data_->At(i).data());
+        output.Append(std::string_view(text, FormatIPv6(bytes, text)));
+    }
+}
+
 void ColumnIPv6::Append(const in6_addr* addr) {
     data_->Append(std::string_view((const char*)addr->s6_addr, 16));
 }
@@ -43,18 +268,10 @@ void ColumnIPv6::Clear() {
 }
 
 std::string ColumnIPv6::AsString (size_t n) const {
-    const auto& addr = this->At(n);
+    const auto bytes = reinterpret_cast<const uint8_t*>(data_->At(n).data());
 
-    char buf[INET6_ADDRSTRLEN];
-    const char* ip_str = inet_ntop(AF_INET6, &addr, buf, INET6_ADDRSTRLEN);
-
-    if (ip_str == nullptr) {
-        throw std::system_error(
-                std::error_code(errno, std::generic_category()),
-                "Invalid IPv6 data");
-    }
-
-    return ip_str;
+    char buf[IPV6_MAX_TEXT_SIZE];
+    return std::string(buf, FormatIPv6(bytes, buf));
 }
 
 in6_addr ColumnIPv6::At(size_t n) const {
@@ -87,6 +304,14 @@ size_t ColumnIPv6::Size() const {
     return data_->Size();
 }
 
+size_t ColumnIPv6::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnIPv6::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnIPv6::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnIPv6>(data_->Slice(begin, len));
 }
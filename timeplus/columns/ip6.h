@@ -1,7 +1,10 @@
 #pragma once
 
 #include "string.h"
+#include "../base/span.h"
+
 #include <memory>
+#include <string_view>
 
 struct in6_addr;
 
@@ -34,6 +37,13 @@ public:
 
     std::string AsString(size_t n) const;
 
+    /// Appends addresses in text form, as accepted by inet_pton(AF_INET6, ...).
+    /// Throws ValidationError, leaving the column unchanged, if any of them is malformed.
+    void AppendStrings(Span<const std::string_view> values);
+
+    /// Appends all addresses in text form, as produced by inet_ntop(AF_INET6, ...), to `output`.
+    void ToStrings(ColumnString& output) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -53,6 +63,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
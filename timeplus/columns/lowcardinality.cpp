@@ -6,7 +6,9 @@
 
 #include <city.h>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -80,7 +82,7 @@ inline ResultColumnType & column_down_cast(ColumnType & c) {
 // std::visit-ish function to avoid including <variant> header, which is not present in older version of XCode.
 template <typename Vizitor, typename ColumnType>
 inline auto VisitIndexColumn(Vizitor && vizitor, ColumnType && col) {
-    switch (col.Type()->GetCode()) {
+    switch (col.GetType().GetCode()) {
         case Type::UInt8:
             return vizitor(column_down_cast<ColumnUInt8>(col));
         case Type::UInt16:
@@ -94,6 +96,37 @@ inline auto VisitIndexColumn(Vizitor && vizitor, ColumnType && col) {
     }
 }
 
+IndexType indexTypeForPosition(uint64_t position) {
+    if (position <= std::numeric_limits<uint8_t>::max())
+        return IndexType::UInt8;
+    if (position <= std::numeric_limits<uint16_t>::max())
+        return IndexType::UInt16;
+    if (position <= std::numeric_limits<uint32_t>::max())
+        return IndexType::UInt32;
+    return IndexType::UInt64;
+}
+
+// Returns `index` if its type can hold `position`, otherwise a copy of it with wide enough type.
+ColumnRef FitIndexColumn(ColumnRef index, uint64_t position) {
+    const auto required_type = indexTypeForPosition(position);
+    if (required_type <= indexTypeFromIndexColumn(*index))
+        return index;
+
+    auto result = createIndexColumn(required_type);
+    VisitIndexColumn([&index](auto & target) {
+        using TargetType = typename std::decay_t<decltype(target)>::DataType;
+        VisitIndexColumn([&target](const auto & source) {
+            const auto source_data = source.GetData();
+            auto & target_data = target.GetWritableData();
+            target_data.resize(source_data.size());
+            for (size_t i = 0; i < source_data.size(); ++i) {
+                target_data[i] = static_cast<TargetType>(source_data[i]);
+            }
+        }, *index);
+    }, *result);
+    return result;
+}
+
 // A special NULL-item, which is expected at pos(0) in dictionary,
 // note that we distinguish empty string from NULL-value.
 inline auto GetNullItemForDictionary(const ColumnRef dictionary) {
@@ -179,6 +212,11 @@ void ColumnLowCardinality::Reserve(size_t new_cap) {
     index_column_->Reserve(new_cap);
 }
 
+void ColumnLowCardinality::ReserveDictionary(size_t unique_items) {
+    dictionary_column_->Reserve(unique_items);
+    unique_items_map_.reserve(unique_items);
+}
+
 void ColumnLowCardinality::Setup(ColumnRef dictionary_column) {
     AppendDefaultItem();
 
@@ -202,7 +240,6 @@ std::uint64_t ColumnLowCardinality::getDictionaryIndex(std::uint64_t item_index)
 }
 
 void ColumnLowCardinality::appendIndex(std::uint64_t item_index) {
-    // TODO (nemkov): handle case when index should go from UInt8 to UInt16, etc.
     VisitIndexColumn([item_index](auto & arg) {
         arg.Append(static_cast<typename std::decay_t<decltype(arg)>::DataType>(item_index));
     }, *index_column_);
@@ -215,16 +252,14 @@ void ColumnLowCardinality::removeLastIndex() {
 }
 
 details::LowCardinalityHashKey ColumnLowCardinality::computeHashKey(const ItemView & item) {
-    static const auto hasher = std::hash<ItemView::DataType>{};
     if (item.type == Type::Void) {
         // to distinguish NULL of ColumnNullable and empty string.
         return {0u, 0u};
     }
 
-    const auto hash1 = hasher(item.data);
-    const auto hash2 = CityHash64(item.data.data(), item.data.size());
+    const auto hash = CityHash128(item.data.data(), item.data.size());
 
-    return details::LowCardinalityHashKey{hash1, hash2};
+    return details::LowCardinalityHashKey{Uint128Low64(hash), Uint128High64(hash)};
 }
 
 ColumnRef ColumnLowCardinality::GetDictionary() {
@@ -237,12 +272,14 @@ void ColumnLowCardinality::Append(ColumnRef col) {
     // - same type as dictionary column
 
     auto c = col->As<ColumnLowCardinality>();
-    // If not LowCardinality of same dictionary type
-    if (!c || !dictionary_column_->Type()->IsEqual(c->dictionary_column_->Type())) {
-        // If not column of the same type as dictionary type
-        if (!dictionary_column_->Type()->IsEqual(col->GetType())) {
-            return;
-        }
+    if (c && dictionary_column_->Type()->IsEqual(c->dictionary_column_->Type())) {
+        AppendLowCardinality(*c);
+        return;
+    }
+
+    // If not column of the same type as dictionary type
+    if (!dictionary_column_->Type()->IsEqual(col->GetType())) {
+        return;
     }
 
     for (size_t i = 0; i < col->Size(); ++i) {
@@ -250,6 +287,58 @@ void ColumnLowCardinality::Append(ColumnRef col) {
     }
 }
 
+void ColumnLowCardinality::AppendLowCardinality(const ColumnLowCardinality& other) {
+    if (unique_items_map_pending_) {
+        BuildUniqueItemsMap();
+    }
+
+    // Each dictionary item of `other` is looked up (and added to dictionary if new) only once,
+    // rows are then appended by mapping their positions through the table.
+    // Only items used by rows are looked up, in order of first use, just like appending rows one by one would do.
+    constexpr auto NOT_MAPPED = std::numeric_limits<uint64_t>::max();
+    std::vector<uint64_t> new_positions(other.dictionary_column_->Size(), NOT_MAPPED);
+    if (dictionary_column_->As<ColumnNullable>() && !new_positions.empty()) {
+        new_positions[0] = 0;
+    }
+
+    other.VisitIndexes([&](auto indexes) {
+        for (const auto index : indexes) {
+            auto & new_position = new_positions[index];
+            if (new_position == NOT_MAPPED) {
+                new_position = FindOrAppendToDictionary(other.dictionary_column_->GetItem(index));
+            }
+        }
+    });
+
+    index_column_ = FitIndexColumn(index_column_, dictionary_column_->Size() - 1);
+
+    VisitIndexColumn([&](auto & index) {
+        using IndexType = typename std::decay_t<decltype(index)>::DataType;
+
+        std::vector<IndexType> typed_positions(new_positions.size());
+        for (size_t i = 0; i < new_positions.size(); ++i) {
+            typed_positions[i] = static_cast<IndexType>(new_positions[i]);
+        }
+
+        // Reserve before getting indexes of `other`, which may be `this`.
+        // Growing geometrically, since many blocks are usually appended one after another.
+        auto & data = index.GetWritableData();
+        const auto initial_size = data.size();
+        if (data.capacity() < initial_size + other.Size()) {
+            data.reserve(std::max(initial_size + other.Size(), data.capacity() * 2));
+        }
+
+        other.VisitIndexes([&](auto indexes) {
+            data.resize(initial_size + indexes.size());
+            IndexType* target = data.data() + initial_size;
+            const IndexType* positions = typed_positions.data();
+            for (size_t i = 0; i < indexes.size(); ++i) {
+                target[i] = positions[indexes[i]];
+            }
+        });
+    }, *index_column_);
+}
+
 namespace {
 
 auto Load(ColumnRef new_dictionary_column, InputStream& input, size_t rows) {
@@ -300,16 +389,29 @@ auto Load(ColumnRef new_dictionary_column, InputStream& input, size_t rows) {
         }
     }
 
-    ColumnLowCardinality::UniqueItems new_unique_items_map;
-    for (size_t i = 0; i < dataColumn->Size(); ++i) {
-        const auto key = ColumnLowCardinality::computeHashKey(new_dictionary_column->GetItem(i));
-        new_unique_items_map.emplace(key, i);
-    }
-
     // suffix
     // NOP
 
-    return std::make_tuple(new_dictionary_column, new_index_column, new_unique_items_map);
+    return std::make_pair(new_dictionary_column, new_index_column);
+}
+
+void Save(Column & dictionary, Column & index, OutputStream& output) {
+    const uint64_t index_serialization_type = indexTypeFromIndexColumn(index) | IndexFlag::HasAdditionalKeysBit;
+    WireFormat::WriteFixed(output, index_serialization_type);
+
+    const uint64_t number_of_keys = dictionary.Size();
+    WireFormat::WriteFixed(output, number_of_keys);
+
+    if (auto columnNullable = dictionary.As<ColumnNullable>()) {
+        columnNullable->Nested()->SaveBody(&output);
+    } else {
+        dictionary.SaveBody(&output);
+    }
+
+    const uint64_t number_of_rows = index.Size();
+    WireFormat::WriteFixed(output, number_of_rows);
+
+    index.SaveBody(&output);
 }
 
 }
@@ -328,11 +430,13 @@ bool ColumnLowCardinality::LoadPrefix(InputStream* input, size_t) {
 
 bool ColumnLowCardinality::LoadBody(InputStream* input, size_t rows) {
     try {
-        auto [new_dictionary, new_index, new_unique_items_map] = ::Load(dictionary_column_->CloneEmpty(), *input, rows);
+        auto [new_dictionary, new_index] = ::Load(dictionary_column_->CloneEmpty(), *input, rows);
 
         dictionary_column_->Swap(*new_dictionary);
         index_column_.swap(new_index);
-        unique_items_map_.swap(new_unique_items_map);
+        // Consumers of loaded data rarely append to it, so hash index of the dictionary is built on first append.
+        unique_items_map_.clear();
+        unique_items_map_pending_ = true;
 
         return true;
     } catch (...) {
@@ -346,28 +450,82 @@ void ColumnLowCardinality::SavePrefix(OutputStream* output) {
 }
 
 void ColumnLowCardinality::SaveBody(OutputStream* output) {
-    const uint64_t index_serialization_type = indexTypeFromIndexColumn(*index_column_) | IndexFlag::HasAdditionalKeysBit;
-    WireFormat::WriteFixed(*output, index_serialization_type);
+    if (dictionary_cache_limit_ && !UsesWholeDictionary()) {
+        // Cached dictionary contains items of previous blocks not used by current rows, send only the used ones.
+        auto [dictionary, index] = CompactDictionary();
+        ::Save(*dictionary, *index, *output);
+    } else {
+        ::Save(*dictionary_column_, *index_column_, *output);
+    }
+}
 
-    const uint64_t number_of_keys = dictionary_column_->Size();
-    WireFormat::WriteFixed(*output, number_of_keys);
+bool ColumnLowCardinality::UsesWholeDictionary() const {
+    // Null and default items are always sent, whether used or not.
+    const size_t reserved_items = dictionary_column_->As<ColumnNullable>() ? 2 : 1;
+    const size_t dictionary_size = dictionary_column_->Size();
+    if (dictionary_size <= reserved_items) {
+        return true;
+    }
+    if (index_column_->Size() < dictionary_size - reserved_items) {
+        return false;
+    }
 
-    if (auto columnNullable = dictionary_column_->As<ColumnNullable>()) {
-        columnNullable->Nested()->SaveBody(output);
-    } else {
-        dictionary_column_->SaveBody(output);
+    std::vector<uint8_t> used(dictionary_size, 0);
+    size_t used_count = reserved_items;
+    std::fill_n(used.begin(), reserved_items, 1);
+
+    VisitIndexColumn([&](const auto & index) {
+        for (const auto position : index.GetData()) {
+            used_count += !used[position];
+            used[position] = 1;
+        }
+    }, *index_column_);
+
+    return used_count == dictionary_size;
+}
+
+std::pair<ColumnRef, ColumnRef> ColumnLowCardinality::CompactDictionary() const {
+    constexpr auto NOT_USED = std::numeric_limits<uint64_t>::max();
+
+    auto new_dictionary = dictionary_column_->CloneEmpty();
+    auto new_index = index_column_->CloneEmpty();
+    new_index->Reserve(index_column_->Size());
+
+    // Null and default items must stay at their positions, loaded dictionary may lack them.
+    const size_t reserved_items = std::min<size_t>(dictionary_column_->As<ColumnNullable>() ? 2 : 1, dictionary_column_->Size());
+    std::vector<uint64_t> new_positions(dictionary_column_->Size(), NOT_USED);
+    for (size_t i = 0; i < reserved_items; ++i) {
+        new_positions[i] = i;
+        AppendToDictionary(*new_dictionary, dictionary_column_->GetItem(i));
     }
 
-    const uint64_t number_of_rows = index_column_->Size();
-    WireFormat::WriteFixed(*output, number_of_rows);
+    VisitIndexColumn([&](const auto & index) {
+        auto & result = column_down_cast<std::decay_t<decltype(index)>>(*new_index);
+        using IndexType = typename std::decay_t<decltype(index)>::DataType;
+
+        for (size_t i = 0; i < index.Size(); ++i) {
+            auto & new_position = new_positions[index[i]];
+            if (new_position == NOT_USED) {
+                new_position = new_dictionary->Size();
+                AppendToDictionary(*new_dictionary, dictionary_column_->GetItem(index[i]));
+            }
+            result.Append(static_cast<IndexType>(new_position));
+        }
+    }, *index_column_);
 
-    index_column_->SaveBody(output);
+    return {new_dictionary, new_index};
 }
 
 void ColumnLowCardinality::Clear() {
+    if (dictionary_cache_limit_ && dictionary_column_->Size() <= dictionary_cache_limit_) {
+        index_column_->Clear();
+        return;
+    }
+
     index_column_->Clear();
     dictionary_column_->Clear();
     unique_items_map_.clear();
+    unique_items_map_pending_ = false;
 
     if (auto columnNullable = dictionary_column_->As<ColumnNullable>()) {
         AppendNullItem();
@@ -379,6 +537,14 @@ size_t ColumnLowCardinality::Size() const {
     return index_column_->Size();
 }
 
+size_t ColumnLowCardinality::ByteSize() const {
+    return dictionary_column_->ByteSize() + index_column_->ByteSize();
+}
+
+size_t ColumnLowCardinality::AllocatedBytes() const {
+    return dictionary_column_->AllocatedBytes() + index_column_->AllocatedBytes() + unique_items_map_.allocated_bytes();
+}
+
 ColumnRef ColumnLowCardinality::Slice(size_t begin, size_t len) const {
     begin = std::min(begin, Size());
     len = std::min(len, Size() - begin);
@@ -407,6 +573,8 @@ void ColumnLowCardinality::Swap(Column& other) {
 
     index_column_.swap(col.index_column_);
     unique_items_map_.swap(col.unique_items_map_);
+    std::swap(unique_items_map_pending_, col.unique_items_map_pending_);
+    std::swap(dictionary_cache_limit_, col.dictionary_cache_limit_);
 }
 
 ItemView ColumnLowCardinality::GetItem(size_t index) const {
@@ -425,11 +593,19 @@ ItemView ColumnLowCardinality::GetItem(size_t index) const {
 
 // No checks regarding value type or validity of value is made.
 void ColumnLowCardinality::AppendUnsafe(const ItemView & value) {
+    if (unique_items_map_pending_) {
+        BuildUniqueItemsMap();
+    }
+
     const auto key = computeHashKey(value);
     const auto initial_index_size = index_column_->Size();
     // If the value is unique, then we are going to append it to a dictionary, hence new index is Size().
     auto [iterator, is_new_item] = unique_items_map_.try_emplace(key, dictionary_column_->Size());
     try {
+        if (is_new_item) {
+            index_column_ = FitIndexColumn(index_column_, iterator->second);
+        }
+
         // Order is important, adding to dictionary last, since it is much (MUCH!!!!) harder
         // to remove item from dictionary column than from index column
         // (also, there is currently no API to do that).
@@ -451,6 +627,19 @@ void ColumnLowCardinality::AppendUnsafe(const ItemView & value) {
     }
 }
 
+size_t ColumnLowCardinality::FindOrAppendToDictionary(const ItemView & value) {
+    auto [iterator, is_new_item] = unique_items_map_.try_emplace(computeHashKey(value), dictionary_column_->Size());
+    if (is_new_item) {
+        try {
+            AppendToDictionary(*dictionary_column_, value);
+        } catch (...) {
+            unique_items_map_.erase(iterator);
+            throw;
+        }
+    }
+    return iterator->second;
+}
+
 void ColumnLowCardinality::AppendNullItem()
 {
     const auto null_item = GetNullItemForDictionary(dictionary_column_);
@@ -465,6 +654,33 @@ void ColumnLowCardinality::AppendDefaultItem()
     AppendToDictionary(*dictionary_column_, defaultItem);
 }
 
+void ColumnLowCardinality::BuildUniqueItemsMap() {
+    unique_items_map_.clear();
+    unique_items_map_.reserve(dictionary_column_->Size());
+
+    for (size_t i = 0; i < dictionary_column_->Size(); ++i) {
+        unique_items_map_.emplace(computeHashKey(dictionary_column_->GetItem(i)), i);
+    }
+
+    unique_items_map_pending_ = false;
+}
+
+ColumnRef ColumnLowCardinality::GetDictionaryColumn() const {
+    return dictionary_column_;
+}
+
+Type::Code ColumnLowCardinality::GetIndexType() const {
+    return index_column_->GetType().GetCode();
+}
+
+void ColumnLowCardinality::SetDictionaryCacheLimit(size_t max_dictionary_size) {
+    dictionary_cache_limit_ = max_dictionary_size;
+}
+
+size_t ColumnLowCardinality::GetDictionaryCacheLimit() const {
+    return dictionary_cache_limit_;
+}
+
 size_t ColumnLowCardinality::GetDictionarySize() const {
     return dictionary_column_->Size();
 }
@@ -3,10 +3,10 @@
 #include "column.h"
 #include "numeric.h"
 #include "nullable.h"
+#include "../base/flat_hash_map.h"
 
 #include <functional>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 namespace timeplus {
@@ -19,8 +19,8 @@ namespace details {
 /** LowCardinalityHashKey used as key in unique items hashmap to abstract away key value
  * (type of which depends on dictionary column) and to reduce likelehood of collisions.
  *
- * In order to dramatically reduce collision rate, we use 2 different hashes from 2 different hash functions.
- * First hash is used in hashtable (to calculate item position).
+ * In order to dramatically reduce collision rate, key is a 128-bit hash of the value, computed in a single pass.
+ * First half is used in hashtable (to calculate item position and control byte).
  * Second one is used as part of key value and accessed via `operator==()` upon collision resolution/detection.
  */
 using LowCardinalityHashKey = std::pair<std::uint64_t, std::uint64_t>;
@@ -40,7 +40,7 @@ struct LowCardinalityHashKeyHash {
  * */
 class ColumnLowCardinality : public Column {
 public:
-    using UniqueItems = std::unordered_map<details::LowCardinalityHashKey, size_t /*dictionary index*/, details::LowCardinalityHashKeyHash>;
+    using UniqueItems = FlatHashMap<details::LowCardinalityHashKey, size_t /*dictionary index*/, details::LowCardinalityHashKeyHash>;
 
     template <typename T>
     friend class ColumnLowCardinalityT;
@@ -51,6 +51,9 @@ private:
     ColumnRef dictionary_column_;
     ColumnRef index_column_;
     UniqueItems unique_items_map_;
+    // Set when dictionary was loaded without building unique_items_map_, which is needed only for appending.
+    bool unique_items_map_pending_ = false;
+    size_t dictionary_cache_limit_ = 0;
 
 public:
     ColumnLowCardinality(ColumnLowCardinality&& col) = default;
@@ -68,7 +71,15 @@ public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
 
-    /// Appends another LowCardinality column to the end of this one, updating dictionary.
+    /// Increase the capacity of the dictionary (and its hash index) to hold `unique_items` distinct values without reallocations.
+    void ReserveDictionary(size_t unique_items);
+
+    /** Appends another LowCardinality column (or column of the dictionary type) to the end of this one, updating dictionary.
+     *
+     *  For LowCardinality column only its dictionary items are looked up (once each),
+     *  rows are appended by remapping their dictionary positions.
+     *  Index type is widened as needed, e.g. when merged dictionary doesn't fit into UInt8 positions.
+     */
     void Append(ColumnRef /*column*/) override;
 
     bool LoadPrefix(InputStream* input, size_t rows) override;
@@ -88,6 +99,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of current column, with compacted dictionary
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
@@ -97,6 +114,37 @@ public:
     size_t GetDictionarySize() const;
     TypeRef GetNestedType() const;
 
+    /** Dictionary cache mode, for columns that are filled, sent and cleared over and over again.
+     *
+     *  Clear() keeps the dictionary and its hash index, so values seen in previous blocks
+     *  are appended with a single lookup, without re-hashing them into a fresh table and
+     *  copying them into a fresh dictionary. SaveBody() sends only the dictionary items
+     *  used by current rows.
+     *  Once the dictionary grows beyond `max_dictionary_size` items, Clear() drops it as usual.
+     *  0 (default) disables the mode.
+     */
+    void SetDictionaryCacheLimit(size_t max_dictionary_size);
+    size_t GetDictionaryCacheLimit() const;
+
+    /** Dictionary-encoded access, e.g. to group or filter rows by integer codes instead of values.
+     *
+     *  Each row is stored as a position of its value in the dictionary column.
+     *  For LC(Nullable(T)) item 0 of dictionary is NULL and item 1 is the default value,
+     *  otherwise item 0 is the default value. Dictionary may contain items not used by any row.
+     */
+    ColumnRef GetDictionaryColumn() const;
+
+    /// Type of per-row dictionary positions: UInt8, UInt16, UInt32 or UInt64.
+    Type::Code GetIndexType() const;
+
+    /// Per-row dictionary positions, T must match GetIndexType(), otherwise ValidationError is thrown.
+    template <typename T>
+    Span<const T> GetIndexes() const;
+
+    /// Calls `func` with Span<const uintN_t> of per-row dictionary positions, whatever GetIndexType() is.
+    template <typename Func>
+    decltype(auto) VisitIndexes(Func && func) const;
+
 protected:
     std::uint64_t getDictionaryIndex(std::uint64_t item_index) const;
     void appendIndex(std::uint64_t item_index);
@@ -107,6 +155,14 @@ protected:
 
 private:
     void Setup(ColumnRef dictionary_column);
+    void BuildUniqueItemsMap();
+    /// Whether every dictionary item is used by some row, so the dictionary can be sent as is.
+    bool UsesWholeDictionary() const;
+    /// Returns copy of dictionary with items used by index only, and index remapped to it.
+    std::pair<ColumnRef, ColumnRef> CompactDictionary() const;
+    void AppendLowCardinality(const ColumnLowCardinality& other);
+    /// Returns position of `value` in dictionary, appending it there if it is not found.
+    size_t FindOrAppendToDictionary(const ItemView & value);
     void AppendNullItem();
     void AppendDefaultItem();
 
@@ -114,6 +170,31 @@ public:
     static details::LowCardinalityHashKey computeHashKey(const ItemView &);
 };
 
+template <typename T>
+Span<const T> ColumnLowCardinality::GetIndexes() const {
+    if (auto index = dynamic_cast<const ColumnVector<T>*>(index_column_.get())) {
+        return index->GetData();
+    }
+
+    throw ValidationError("Requested index type doesn't match index column type " + index_column_->GetType().GetName());
+}
+
+template <typename Func>
+decltype(auto) ColumnLowCardinality::VisitIndexes(Func && func) const {
+    switch (GetIndexType()) {
+        case Type::UInt8:
+            return func(GetIndexes<uint8_t>());
+        case Type::UInt16:
+            return func(GetIndexes<uint16_t>());
+        case Type::UInt32:
+            return func(GetIndexes<uint32_t>());
+        case Type::UInt64:
+            return func(GetIndexes<uint64_t>());
+        default:
+            throw ValidationError("Invalid index column type " + index_column_->GetType().GetName());
+    }
+}
+
 /** Type-aware wrapper that provides simple convenience interface for accessing/appending individual items.
  */
 template <typename DictionaryColumnType>
@@ -148,6 +229,11 @@ public:
 
     /// Extended interface to simplify reading/adding individual items.
 
+    /// Dictionary column of the wrapped type, see ColumnLowCardinality::GetDictionaryColumn().
+    inline const DictionaryColumnType& GetTypedDictionary() const {
+        return typed_dictionary_;
+    }
+
     /// Returns element at given row number.
     inline ValueType At(size_t n) const {
         return typed_dictionary_.At(getDictionaryIndex(n));
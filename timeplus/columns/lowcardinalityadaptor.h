@@ -47,8 +47,13 @@ public:
         // It safe to reuse `flat_data_column` later since ColumnLowCardinalityT makes a deep copy, but still check just in case.
         assert(new_data_column->Size() == 0);
 
-        for (size_t i = 0; i < low_cardinality_col.Size(); ++i)
-            new_data_column->Append(low_cardinality_col[i]);
+        // Unwrap straight from dictionary positions, without per-row dispatch on index type.
+        const auto & dictionary = low_cardinality_col.GetTypedDictionary();
+        new_data_column->Reserve(low_cardinality_col.Size());
+        low_cardinality_col.VisitIndexes([&](auto indexes) {
+            for (const auto index : indexes)
+                new_data_column->Append(dictionary[index]);
+        });
 
         this->Swap(*new_data_column);
         return true;
@@ -5,6 +5,8 @@
 #include "../exceptions.h"
 #include "utils.h"
 
+#include <city.h>
+
 namespace {
 
 using namespace timeplus;
@@ -29,6 +31,10 @@ TypeRef GetMapType(const Type& data_type) {
 
 namespace timeplus {
 
+size_t details::MapKeyHash::operator()(std::string_view key) const noexcept {
+    return static_cast<size_t>(CityHash64(key.data(), key.size()));
+}
+
 ColumnMap::ColumnMap(ColumnRef data)
     : Column(GetMapType(data->GetType())), data_(data->As<ColumnArray>()) {
 }
@@ -67,6 +73,14 @@ size_t ColumnMap::Size() const {
     return data_->Size();
 }
 
+size_t ColumnMap::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnMap::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnMap::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnMap>(data_->Slice(begin, len));
 }
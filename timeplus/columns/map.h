@@ -1,18 +1,93 @@
 #pragma once
 
-#include "../base/projected_iterator.h"
+#include "../base/flat_hash_map.h"
 #include "array.h"
 #include "column.h"
 #include "tuple.h"
 
 #include <functional>
 #include <map>
+#include <optional>
 
 namespace timeplus {
 
 template <typename KeyColumnType, typename ValueColumnType>
 class ColumnMapT;
 
+namespace details {
+
+/// Hash of map keys for FlatHashMap, which needs all bits of the hash well mixed (std::hash of integers is identity).
+struct MapKeyHash {
+    size_t operator()(std::string_view key) const noexcept;
+
+    template <typename T>
+    size_t operator()(const T& key) const noexcept {
+        uint64_t hash = static_cast<uint64_t>(std::hash<T>{}(key));
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+};
+
+}
+
+/// Read-only view of consecutive items of a column, i.e. keys or values of a single row of ColumnMapT.
+/// Valid as long as the column is alive and is not modified.
+template <typename ColumnType>
+class ColumnItemsView {
+public:
+    using ValueType = std::decay_t<decltype(std::declval<ColumnType>().At(0))>;
+
+    ColumnItemsView(const ColumnType& column, size_t offset, size_t size)
+        : column_(&column), offset_(offset), size_(size) {}
+
+    inline ValueType operator[](size_t index) const { return (*column_)[offset_ + index]; }
+
+    class Iterator {
+        const ColumnItemsView* view_ = nullptr;
+        size_t index_ = 0;
+
+    public:
+        Iterator() = default;
+
+        Iterator(const ColumnItemsView* view, size_t index) : view_(view), index_(index) {}
+
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueType;
+        using pointer = void;
+        using reference = ValueType;
+        using iterator_category = std::forward_iterator_tag;
+
+        inline ValueType operator*() const { return (*view_)[index_]; }
+
+        inline Iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        inline bool operator==(const Iterator& other) const { return view_ == other.view_ && index_ == other.index_; }
+
+        inline bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    // minimalistic stl-like container interface, hence the lowercase
+    inline Iterator begin() const { return Iterator{this, 0}; }
+
+    inline Iterator end() const { return Iterator{this, size_}; }
+
+    inline size_t size() const { return size_; }
+
+    inline bool empty() const { return size_ == 0; }
+
+private:
+    const ColumnType* column_;
+    size_t offset_;
+    size_t size_;
+};
+
 /**
  * Represents column of Map(K, V).
  */
@@ -49,6 +124,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t, size_t) const override;
     ColumnRef CloneEmpty() const override;
@@ -221,24 +302,105 @@ public:
     inline void Append(const MapValueView& value) { typed_data_->Append(value.data_); }
 
     inline void Append(const std::vector<std::tuple<Key, Value>>& tuples) {
-        typed_data_->Append(tuples.begin(), tuples.end());
+        auto& keys = GetWritableKeys();
+        auto& values = GetWritableValues();
+        for (const auto& [key, value] : tuples) {
+            keys.Append(key);
+            values.Append(value);
+        }
+        typed_data_->EndRow();
     }
 
+    /// Appends one row from any container of pairs, e.g. std::map or std::unordered_map.
     template <typename T>
     inline void Append(const T& value) {
-        using BaseIter = decltype(value.begin());
-        using KeyOfT = decltype(std::declval<BaseIter>()->first);
-        using ValOfT = decltype(std::declval<BaseIter>()->second);
-        using Functor = std::function<std::tuple<KeyOfT, ValOfT>(const BaseIter&)>;
-        using Iterator = ProjectedIterator<Functor, BaseIter>;
-
-        Functor functor = [](const BaseIter& i) {
-            return std::make_tuple(std::cref(i->first), std::cref(i->second));
-        };
+        auto& keys = GetWritableKeys();
+        auto& values = GetWritableValues();
+        for (const auto& item : value) {
+            keys.Append(item.first);
+            values.Append(item.second);
+        }
+        typed_data_->EndRow();
+    }
 
-        typed_data_->Append(Iterator{value.begin(), functor}, Iterator{value.end(), functor});
+    /// Appends one row mapping keys[i] to values[i], directly into the flat key and value columns.
+    /// Throws ValidationError if there are not as many keys as values.
+    void AppendRow(Span<const Key> keys, Span<const Value> values) {
+        CheckSizes(keys.size(), values.size());
+        AppendKeysAndValues(keys, values);
+        typed_data_->EndRow();
     }
 
+    /** Appends many rows at once: i-th row ends at offsets[i] in `keys` and `values`, as in ColumnArray::AppendRows().
+     *  Throws ValidationError, leaving the column unchanged, if offsets are malformed or sizes don't match.
+     *  The column is left unchanged as well if appending any key or value throws.
+     */
+    void AppendRows(Span<const uint64_t> offsets, Span<const Key> keys, Span<const Value> values) {
+        CheckSizes(keys.size(), values.size());
+        ColumnArray::CheckOffsets(offsets, keys.size());
+        AppendKeysAndValues(keys, values);
+        typed_data_->EndRows(offsets);
+    }
+
+    /// Returns keys of all rows back to back, row n spans positions GetRowRange(n) of it.
+    inline const KeyColumnType& GetKeys() const { return typed_data_->GetNestedColumn().template GetColumn<0>(); }
+
+    /// Returns values of all rows back to back, row n spans positions GetRowRange(n) of it.
+    inline const ValueColumnType& GetValues() const { return typed_data_->GetNestedColumn().template GetColumn<1>(); }
+
+    /// Returns position of the first item of given row in GetKeys() and GetValues(), and position past its last item.
+    std::pair<size_t, size_t> GetRowRange(size_t n) const {
+        if (n >= Size())
+            throw ValidationError("ColumnMap row index out of bounds: " + std::to_string(n) + ", max is " + std::to_string(Size()));
+
+        const auto offsets = typed_data_->GetOffsets();
+        return {n == 0 ? 0 : offsets[n - 1], offsets[n]};
+    }
+
+    /// Returns keys of given row: Span into column data when keys are stored as a contiguous array (numbers), ColumnItemsView otherwise.
+    inline auto RowKeys(size_t n) const { return RowItems(GetKeys(), n); }
+
+    /// Returns values of given row, same as RowKeys().
+    inline auto RowValues(size_t n) const { return RowItems(GetValues(), n); }
+
+    /** Hashed index of keys of a single row, for many lookups in a large map, see IndexRow().
+     *  Duplicate keys resolve to the first of them, the same as MapValueView::Find().
+     *  Valid as long as the column is alive and is not modified.
+     */
+    class RowIndex {
+    public:
+        RowIndex(const ColumnMapT& column, size_t n) : values_(&column.GetValues()) {
+            const auto [begin, end] = column.GetRowRange(n);
+            const auto& keys = column.GetKeys();
+
+            positions_.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                positions_.try_emplace(keys[i], i);
+            }
+        }
+
+        /// Returns value for given key, if there is one.
+        inline std::optional<Value> Find(const Key& key) const {
+            const auto item = positions_.find(key);
+            if (!item) {
+                return std::nullopt;
+            }
+            return (*values_)[item->second];
+        }
+
+        inline bool Contains(const Key& key) const { return positions_.find(key) != nullptr; }
+
+        /// Returns count of distinct keys.
+        inline size_t Size() const { return positions_.size(); }
+
+    private:
+        const ValueColumnType* values_;
+        FlatHashMap<Key, size_t, details::MapKeyHash> positions_;
+    };
+
+    /// Builds hashed index of keys of given row; for small maps a linear search in RowKeys() is usually faster.
+    inline RowIndex IndexRow(size_t n) const { return RowIndex{*this, n}; }
+
     static auto Wrap(ColumnMap&& col) {
         auto data = ArrayColumnType::Wrap(std::move(col.data_));
         return std::make_shared<ColumnMapT<K, V>>(std::move(data));
@@ -249,6 +411,44 @@ public:
     // Helper to simplify integration with other APIs
     static auto Wrap(ColumnRef&& col) { return Wrap(std::move(*col->AsStrict<ColumnMap>())); }
 
+private:
+    inline KeyColumnType& GetWritableKeys() { return typed_data_->BeginRow().template GetColumn<0>(); }
+
+    inline ValueColumnType& GetWritableValues() { return typed_data_->BeginRow().template GetColumn<1>(); }
+
+    static void CheckSizes(size_t keys, size_t values) {
+        if (keys != values) {
+            throw ValidationError("ColumnMap keys and values count mismatch: " + std::to_string(keys) + " keys, " + std::to_string(values) + " values");
+        }
+    }
+
+    /// Appends items to the flat key and value columns. If either append throws, drops what was appended to both.
+    void AppendKeysAndValues(Span<const Key> keys, Span<const Value> values) {
+        auto& key_column = GetWritableKeys();
+        auto& value_column = GetWritableValues();
+        const size_t keys_size = key_column.Size();
+        const size_t values_size = value_column.Size();
+        try {
+            details::AppendItems(key_column, keys);
+            details::AppendItems(value_column, values);
+        } catch (...) {
+            details::TruncateColumn(key_column, keys_size);
+            details::TruncateColumn(value_column, values_size);
+            throw;
+        }
+    }
+
+    template <typename ColumnType>
+    auto RowItems(const ColumnType& column, size_t n) const {
+        const auto [begin, end] = GetRowRange(n);
+        using T = std::decay_t<decltype(column.At(0))>;
+        if constexpr (details::HasSpanData<ColumnType, T>::value) {
+            return column.GetData().subspan(begin, end - begin);
+        } else {
+            return ColumnItemsView<ColumnType>{column, begin, end - begin};
+        }
+    }
+
 private:
     std::shared_ptr<ArrayColumnType> typed_data_;
 };
@@ -75,6 +75,10 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override { return size_; }
 
+    /// Nothing is stored, only the count of rows.
+    size_t ByteSize() const override { return 0; }
+    size_t AllocatedBytes() const override { return 0; }
+
     void Swap(Column& other) override {
         auto & col = dynamic_cast<ColumnNothing &>(other);
         std::swap(size_, col.size_);
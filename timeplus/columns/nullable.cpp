@@ -1,8 +1,176 @@
 #include "nullable.h"
 
 #include <assert.h>
+#include <cstring>
 #include <stdexcept>
 
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+#if defined(__SSE2__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define TIMEPLUS_NULL_MAP_AVX2 1
+#endif
+
+namespace {
+
+/// Kernels over the null map, one byte per row. SSE2 is the baseline on x86-64,
+/// AVX2 versions are compiled for that target only and chosen at runtime.
+
+#if defined(__SSE2__)
+inline size_t PopCount(uint32_t value) {
+    return static_cast<size_t>(__builtin_popcount(value));
+}
+
+/// Bit i is set if data[i] is zero.
+inline uint32_t ZeroMask16(const uint8_t* data) {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(values, _mm_setzero_si128())));
+}
+#endif
+
+#if defined(TIMEPLUS_NULL_MAP_AVX2)
+bool HasAVX2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+__attribute__((target("avx2")))
+inline uint32_t ZeroMask32(const uint8_t* data) {
+    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(values, _mm256_setzero_si256())));
+}
+#endif
+
+size_t CountNonZeroDefault(const uint8_t* data, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        count += 16 - PopCount(ZeroMask16(data + i));
+    }
+#endif
+    for (; i < size; ++i) {
+        count += data[i] != 0;
+    }
+    return count;
+}
+
+bool AnyNonZeroDefault(const uint8_t* data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 64 <= size; i += 64) {
+        const __m128i* block = reinterpret_cast<const __m128i*>(data + i);
+        const __m128i any = _mm_or_si128(
+            _mm_or_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+            _mm_or_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xFFFF) {
+            return true;
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Sets bit (i % 8) of bits[i / 8] for every non-zero data[i], `bits` must be zero-filled.
+void PackNonZeroDefault(const uint8_t* data, size_t size, uint8_t* bits) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        const uint16_t mask = static_cast<uint16_t>(~ZeroMask16(data + i));
+        std::memcpy(bits + i / 8, &mask, sizeof(mask));
+    }
+#endif
+    for (; i < size; ++i) {
+        bits[i / 8] |= static_cast<uint8_t>((data[i] != 0) << (i % 8));
+    }
+}
+
+#if defined(TIMEPLUS_NULL_MAP_AVX2)
+__attribute__((target("avx2")))
+size_t CountNonZeroAVX2(const uint8_t* data, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        count += 32 - static_cast<size_t>(__builtin_popcount(ZeroMask32(data + i)));
+    }
+    return count + CountNonZeroDefault(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+bool AnyNonZeroAVX2(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    for (; i + 128 <= size; i += 128) {
+        const __m256i* block = reinterpret_cast<const __m256i*>(data + i);
+        const __m256i any = _mm256_or_si256(
+            _mm256_or_si256(_mm256_loadu_si256(block), _mm256_loadu_si256(block + 1)),
+            _mm256_or_si256(_mm256_loadu_si256(block + 2), _mm256_loadu_si256(block + 3)));
+        if (!_mm256_testz_si256(any, any)) {
+            return true;
+        }
+    }
+    return AnyNonZeroDefault(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+void PackNonZeroAVX2(const uint8_t* data, size_t size, uint8_t* bits) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const uint32_t mask = ~ZeroMask32(data + i);
+        std::memcpy(bits + i / 8, &mask, sizeof(mask));
+    }
+    PackNonZeroDefault(data + i, size - i, bits + i / 8);
+}
+#endif
+
+size_t CountNonZero(const uint8_t* data, size_t size) {
+#if defined(TIMEPLUS_NULL_MAP_AVX2)
+    if (HasAVX2()) {
+        return CountNonZeroAVX2(data, size);
+    }
+#endif
+    return CountNonZeroDefault(data, size);
+}
+
+bool AnyNonZero(const uint8_t* data, size_t size) {
+#if defined(TIMEPLUS_NULL_MAP_AVX2)
+    if (HasAVX2()) {
+        return AnyNonZeroAVX2(data, size);
+    }
+#endif
+    return AnyNonZeroDefault(data, size);
+}
+
+void PackNonZero(const uint8_t* data, size_t size, uint8_t* bits) {
+#if defined(TIMEPLUS_NULL_MAP_AVX2)
+    if (HasAVX2()) {
+        return PackNonZeroAVX2(data, size, bits);
+    }
+#endif
+    PackNonZeroDefault(data, size, bits);
+}
+
+/// Expands bits to bytes 0/1, 8 rows at a time: each byte picks its own bit of the multiplied-out source byte.
+void UnpackBits(const uint8_t* bits, size_t size, uint8_t* data) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const uint64_t spread = (bits[i / 8] * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+        const uint64_t bytes = ((spread + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+        std::memcpy(data + i, &bytes, sizeof(bytes));
+    }
+    for (; i < size; ++i) {
+        data[i] = (bits[i / 8] >> (i % 8)) & 1;
+    }
+}
+
+}
+
 namespace timeplus {
 
 ColumnNullable::ColumnNullable(ColumnRef nested, ColumnRef nulls)
@@ -34,6 +202,54 @@ ColumnRef ColumnNullable::Nulls() const
        return nulls_;
 }
 
+Span<const uint8_t> ColumnNullable::GetNullMap() const {
+    return nulls_->GetData();
+}
+
+std::vector<uint8_t> ColumnNullable::GetPackedNullMap() const {
+    const auto null_map = GetNullMap();
+    std::vector<uint8_t> result((null_map.size() + 7) / 8, 0);
+
+    PackNonZero(null_map.data(), null_map.size(), result.data());
+    return result;
+}
+
+size_t ColumnNullable::CountNulls() const {
+    const auto null_map = GetNullMap();
+    return CountNonZero(null_map.data(), null_map.size());
+}
+
+bool ColumnNullable::HasAnyNull() const {
+    const auto null_map = GetNullMap();
+    return AnyNonZero(null_map.data(), null_map.size());
+}
+
+void ColumnNullable::AppendNested(ColumnRef nested, Span<const uint8_t> null_map) {
+    if (nested->Size() != null_map.size()) {
+        throw ValidationError("count of elements in nested and nulls should be the same");
+    }
+    if (!nested->Type()->IsEqual(nested_->Type())) {
+        throw ValidationError("Can't append column of type " + nested->Type()->GetName() + " to " + Type()->GetName());
+    }
+
+    nested_->Append(nested);
+    auto& nulls = nulls_->GetWritableData();
+    nulls.insert(nulls.end(), null_map.begin(), null_map.end());
+}
+
+void ColumnNullable::AppendNestedPacked(ColumnRef nested, const uint8_t* packed_null_map) {
+    if (!nested->Type()->IsEqual(nested_->Type())) {
+        throw ValidationError("Can't append column of type " + nested->Type()->GetName() + " to " + Type()->GetName());
+    }
+
+    const size_t rows = nested->Size();
+    nested_->Append(nested);
+    auto& nulls = nulls_->GetWritableData();
+    const size_t offset = nulls.size();
+    nulls.resize(offset + rows);
+    UnpackBits(packed_null_map, rows, nulls.data() + offset);
+}
+
 void ColumnNullable::Reserve(size_t new_cap) {
     nested_->Reserve(new_cap);
     nulls_->Reserve(new_cap);
@@ -82,6 +298,14 @@ size_t ColumnNullable::Size() const {
     return nulls_->Size();
 }
 
+size_t ColumnNullable::ByteSize() const {
+    return nested_->ByteSize() + nulls_->ByteSize();
+}
+
+size_t ColumnNullable::AllocatedBytes() const {
+    return nested_->AllocatedBytes() + nulls_->AllocatedBytes();
+}
+
 ColumnRef ColumnNullable::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnNullable>(nested_->Slice(begin, len), nulls_->Slice(begin, len));
 }
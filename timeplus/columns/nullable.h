@@ -4,6 +4,7 @@
 #include "numeric.h"
 
 #include <optional>
+#include <vector>
 
 namespace timeplus {
 
@@ -26,6 +27,26 @@ public:
     /// Returns nulls column.
     ColumnRef Nulls() const;
 
+    /// Returns null flags of all rows as contiguous read-only view, non-zero byte means null.
+    Span<const uint8_t> GetNullMap() const;
+
+    /// Returns null flags packed to bits: bit (i % 8) of byte (i / 8) is set if i-th row is null.
+    std::vector<uint8_t> GetPackedNullMap() const;
+
+    /// Returns number of nulls in the column.
+    size_t CountNulls() const;
+
+    /// Returns true if at least one row is null, stops at the first one.
+    bool HasAnyNull() const;
+
+    /// Appends all rows of `nested` (column of the nested type), i-th row is null if null_map[i] is non-zero.
+    /// Throws ValidationError if type or size of `nested` doesn't match.
+    void AppendNested(ColumnRef nested, Span<const uint8_t> null_map);
+
+    /// Same as AppendNested(), but null flags are packed to bits as returned by GetPackedNullMap().
+    /// `packed_null_map` must contain at least (nested->Size() + 7) / 8 bytes.
+    void AppendNestedPacked(ColumnRef nested, const uint8_t* packed_null_map);
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -51,6 +72,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
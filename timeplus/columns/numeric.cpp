@@ -3,93 +3,191 @@
 
 #include "../base/wire_format.h"
 
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
 namespace timeplus {
 
 template <typename T>
 ColumnVector<T>::ColumnVector()
     : Column(Type::CreateSimple<T>())
+    , data_(std::make_shared<std::vector<T>>())
 {
 }
 
 template <typename T>
 ColumnVector<T>::ColumnVector(const std::vector<T> & data)
     : Column(Type::CreateSimple<T>())
-    , data_(data)
+    , data_(std::make_shared<std::vector<T>>(data))
 {
 }
 
 template <typename T>
 ColumnVector<T>::ColumnVector(std::vector<T> && data)
     : Column(Type::CreateSimple<T>())
-    , data_(std::move(data))
+    , data_(std::make_shared<std::vector<T>>(std::move(data)))
 {
 }
 
 template <typename T>
 void ColumnVector<T>::Append(const T& value) {
-    data_.push_back(value);
+    Detach();
+    data_->push_back(value);
+}
+
+template <typename T>
+void ColumnVector<T>::AppendRange(const T* values, size_t count) {
+    // `values` may point into this very column (e.g. self-append), so memory Detach() releases
+    // has to outlive the copy, and own elements have to be addressed by offset across reallocation.
+    // Elements shared with slices stay alive anyway, slices keep referring to them.
+    const auto external = external_;
+    Detach(Size() + count);
+
+    auto& data = *data_;
+    const auto size = data.size();
+    if (std::less_equal<const T*>()(data.data(), values) && std::less<const T*>()(values, data.data() + size)) {
+        const auto offset = static_cast<size_t>(values - data.data());
+        data.resize(size + count);
+        std::copy_n(data.data() + offset, count, data.data() + size);
+    } else {
+        data.insert(data.end(), values, values + count);
+    }
+}
+
+template <typename T>
+void ColumnVector<T>::Adopt(std::shared_ptr<const T> data, size_t size) {
+    Reset();
+    external_ = std::move(data);
+    external_size_ = size;
+    external_allocated_ = size * sizeof(T);
+}
+
+template <typename T>
+void ColumnVector<T>::Detach(size_t capacity) {
+    if (!external_ && data_.use_count() == 1) {
+        return;
+    }
+
+    const auto elements = GetData();
+    auto data = std::make_shared<std::vector<T>>();
+    data->reserve(std::max(capacity, elements.size()));
+    data->assign(elements.begin(), elements.end());
+    data_ = std::move(data);
+    external_.reset();
+    external_size_ = 0;
+}
+
+template <typename T>
+void ColumnVector<T>::Reset() {
+    if (data_.use_count() == 1) {
+        data_->clear();
+    } else {
+        data_ = std::make_shared<std::vector<T>>();
+    }
+    external_.reset();
+    external_size_ = 0;
 }
 
 template <typename T>
 void ColumnVector<T>::Erase(size_t pos, size_t count) {
-    const auto begin = std::min(pos, data_.size());
-    const auto last = begin + std::min(data_.size() - begin, count);
+    Detach();
+    auto& data = *data_;
+    const auto begin = std::min(pos, data.size());
+    const auto last = begin + std::min(data.size() - begin, count);
 
-    data_.erase(data_.begin() + begin, data_.begin() + last);
+    data.erase(data.begin() + begin, data.begin() + last);
 }
 
 template <typename T>
 std::vector<T>& ColumnVector<T>::GetWritableData() {
-    return data_;
+    Detach();
+    return *data_;
 }
 
 template <typename T>
 void ColumnVector<T>::Reserve(size_t new_cap) {
-    data_.reserve(new_cap);
+    Detach(new_cap);
+    data_->reserve(new_cap);
 }
 
 template <typename T>
 size_t ColumnVector<T>::Capacity() const {
-    return data_.capacity();
+    return external_ ? external_size_ : data_->capacity();
 }
 
 template <typename T>
 void ColumnVector<T>::Clear() {
-    data_.clear();
+    Reset();
 }
 
 template <typename T>
 const T& ColumnVector<T>::At(size_t n) const {
-    return data_.at(n);
+    if (external_) {
+        if (n >= external_size_) {
+            throw std::out_of_range("ColumnVector::At: index " + std::to_string(n) + " is out of range");
+        }
+        return external_.get()[n];
+    }
+    return data_->at(n);
 }
 
 template <typename T>
 void ColumnVector<T>::Append(ColumnRef column) {
     if (auto col = column->As<ColumnVector<T>>()) {
-        data_.insert(data_.end(), col->data_.begin(), col->data_.end());
+        const auto data = col->GetData();
+        AppendRange(data.data(), data.size());
     }
 }
 
 template <typename T>
 bool ColumnVector<T>::LoadBody(InputStream* input, size_t rows) {
-    data_.resize(rows);
+    Reset();
+    data_->resize(rows);
 
-    return WireFormat::ReadBytes(*input, data_.data(), data_.size() * sizeof(T));
+    return WireFormat::ReadBytes(*input, data_->data(), data_->size() * sizeof(T));
 }
 
 template <typename T>
 void ColumnVector<T>::SaveBody(OutputStream* output) {
-    WireFormat::WriteBytes(*output, data_.data(), data_.size() * sizeof(T));
+    const auto data = GetData();
+    WireFormat::WriteBytes(*output, data.data(), data.size() * sizeof(T));
 }
 
 template <typename T>
 size_t ColumnVector<T>::Size() const {
-    return data_.size();
+    return external_ ? external_size_ : data_->size();
+}
+
+template <typename T>
+size_t ColumnVector<T>::ByteSize() const {
+    return Size() * sizeof(T);
+}
+
+template <typename T>
+size_t ColumnVector<T>::AllocatedBytes() const {
+    return data_->capacity() * sizeof(T) + (external_ ? external_allocated_ : 0);
 }
 
 template <typename T>
 ColumnRef ColumnVector<T>::Slice(size_t begin, size_t len) const {
-    return std::make_shared<ColumnVector<T>>(SliceVector(data_, begin, len));
+    auto result = std::make_shared<ColumnVector<T>>();
+
+    const size_t size = Size();
+    if (begin < size && len) {
+        len = std::min(len, size - begin);
+        // Only references are copied, so slicing is safe alongside other readers of the column.
+        if (external_) {
+            result->Adopt(std::shared_ptr<const T>(external_, external_.get() + begin), len);
+            result->external_allocated_ = external_allocated_;
+        } else {
+            result->Adopt(std::shared_ptr<const T>(data_, data_->data() + begin), len);
+            result->external_allocated_ = data_->capacity() * sizeof(T);
+        }
+    }
+
+    return result;
 }
 
 template <typename T>
@@ -101,11 +199,14 @@ template <typename T>
 void ColumnVector<T>::Swap(Column& other) {
     auto & col = dynamic_cast<ColumnVector<T> &>(other);
     data_.swap(col.data_);
+    external_.swap(col.external_);
+    std::swap(external_size_, col.external_size_);
+    std::swap(external_allocated_, col.external_allocated_);
 }
 
 template <typename T>
 ItemView ColumnVector<T>::GetItem(size_t index) const  {
-    return ItemView{type_->GetCode(), data_[index]};
+    return ItemView{type_->GetCode(), GetData()[index]};
 }
 
 template class ColumnVector<int8_t>;
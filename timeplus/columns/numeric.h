@@ -1,6 +1,7 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
 #include "absl/numeric/int128.h"
 #include "timeplus/base/wide_integer.h"
 #include "timeplus/base/wide_integer_to_string.h"
@@ -29,6 +30,26 @@ public:
     /// Appends one element to the end of column.
     void Append(const T& value);
 
+    /// Appends `count` elements starting at `values`.
+    void AppendRange(const T* values, size_t count);
+
+    /** Replaces content of the column with `size` elements at `data`, without copying them.
+     *
+     *  Memory stays owned by the caller: `deleter(data)` is called once the column no longer needs it
+     *  (column is cleared, modified or destroyed). The elements must not change until then.
+     *  Reading and saving use the memory directly, any modification copies the elements into the column first.
+     */
+    template <typename Deleter>
+    void Adopt(const T* data, size_t size, Deleter deleter) {
+        Adopt(std::shared_ptr<const T>(data, std::move(deleter)), size);
+    }
+
+    /// Same as above, with memory owned by (possibly shared) `data`.
+    void Adopt(std::shared_ptr<const T> data, size_t size);
+
+    /// Returns true if the column refers to adopted memory or is a slice of another column.
+    inline bool IsAdopted() const { return external_ != nullptr; }
+
     /// Returns element at given row number.
     const T& At(size_t n) const;
 
@@ -37,9 +58,15 @@ public:
 
     void Erase(size_t pos, size_t count = 1);
 
-    /// Get Raw Vector Contents
+    /// Get Raw Vector Contents.
+    /// Elements shared with slices are copied first, so call it again after Slice() instead of keeping the reference.
     std::vector<T>& GetWritableData();
 
+    /// Returns all elements as contiguous read-only view.
+    inline Span<const T> GetData() const {
+        return external_ ? Span<const T>(external_.get(), external_size_) : Span<const T>(data_->data(), data_->size());
+    }
+
     /// Returns the capacity of the column
     size_t Capacity() const;
 
@@ -59,7 +86,14 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
-    /// Makes slice of the current column.
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
+    /// Makes slice of the current column, which shares memory with this one instead of copying it.
+    /// Whichever column is modified afterwards copies its elements first (copy-on-write).
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
     void Swap(Column& other) override;
@@ -67,7 +101,21 @@ public:
     ItemView GetItem(size_t index) const override;
 
 private:
-    std::vector<T> data_;
+    /// Makes data_ hold the elements and be referenced by this column only, reserving at least `capacity`.
+    /// Adopted memory is released, elements shared with slices are copied.
+    void Detach(size_t capacity = 0);
+
+    /// Drops all elements, keeping capacity of data_ unless slices refer to it.
+    void Reset();
+
+private:
+    /// Own elements, referenced by slices as well (hence shared_ptr), never null.
+    std::shared_ptr<std::vector<T>> data_;
+    /// Adopted memory or elements of another column this one is a slice of, used instead of data_ until the column is modified.
+    std::shared_ptr<const T> external_;
+    size_t external_size_ = 0;
+    /// Size of the whole allocation external_ points into, in bytes.
+    size_t external_allocated_ = 0;
 };
 
 // using Int128 = absl::int128;
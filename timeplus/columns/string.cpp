@@ -1,11 +1,16 @@
 #include "string.h"
 #include "utils.h"
 
+#include "../base/input.h"
+#include "../base/output.h"
 #include "../base/wire_format.h"
 
+#include <algorithm>
+
 namespace {
 
 constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
+constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
 
 template <typename Container>
 size_t ComputeTotalSize(const Container & strings, size_t begin = 0, size_t len = -1) {
@@ -20,6 +25,97 @@ size_t ComputeTotalSize(const Container & strings, size_t begin = 0, size_t len
     return result;
 }
 
+/// Memory held by storage blocks and stolen strings of ColumnString.
+template <typename Blocks>
+size_t StorageBytes(const Blocks & blocks, const std::deque<std::string> & append_data) {
+    size_t result = 0;
+    for (const auto & block : blocks)
+        result += block.capacity;
+    for (const auto & str : append_data)
+        result += str.capacity();
+
+    return result;
+}
+
+/** Reads `rows` length-prefixed strings, calling `allocate(len)` for each one to get memory to read it into.
+ *
+ *  Whenever input exposes contiguous bytes, lengths are decoded and values copied right from
+ *  that memory, going back to the stream only once per window. Values that cross window
+ *  boundary (or any value, if input is not a ZeroCopyInput) are read with per-value stream calls.
+ */
+template <typename Allocate>
+bool ReadStrings(timeplus::InputStream* input, size_t rows, Allocate&& allocate) {
+    using timeplus::WireFormat;
+
+    auto zero_copy = dynamic_cast<timeplus::ZeroCopyInput*>(input);
+
+    size_t i = 0;
+    while (i < rows) {
+        const void* window = nullptr;
+        const size_t avail = zero_copy ? zero_copy->Peek(&window) : 0;
+        const auto data = static_cast<const uint8_t*>(window);
+
+        size_t consumed = 0;
+        for (; i < rows; ++i) {
+            uint64_t len;
+            const size_t len_size = WireFormat::DecodeVarint64(data + consumed, avail - consumed, &len);
+            if (len_size == 0 || len > avail - consumed - len_size)
+                break;
+
+            consumed += len_size;
+            memcpy(allocate(len), data + consumed, len);
+            consumed += len;
+        }
+
+        if (consumed) {
+            zero_copy->Skip(consumed);
+            if (consumed == avail)
+                continue;
+        }
+
+        if (i == rows)
+            break;
+
+        uint64_t len;
+        if (!WireFormat::ReadUInt64(*input, &len))
+            return false;
+
+        if (!WireFormat::ReadBytes(*input, allocate(len), len))
+            return false;
+
+        ++i;
+    }
+
+    return true;
+}
+
+void WriteString(timeplus::OutputStream& output, std::string_view value) {
+    timeplus::WireFormat::WriteString(output, value);
+}
+
+/// Writes length-prefixed string with a single stream call when output hands out enough contiguous memory.
+void WriteString(timeplus::ZeroCopyOutput& output, std::string_view value) {
+    using timeplus::WireFormat;
+
+    uint8_t header[WireFormat::MAX_VARINT64_BYTES];
+    const size_t header_size = WireFormat::EncodeVarint64(value.size(), header);
+
+    void* window = nullptr;
+    const size_t avail = output.Next(&window, header_size + value.size());
+    auto pos = static_cast<uint8_t*>(window);
+
+    // Fill whatever was handed out, the rest (if any) goes through the regular write path.
+    const size_t header_part = std::min(avail, header_size);
+    memcpy(pos, header, header_part);
+    const size_t value_part = avail - header_part;
+    if (value_part) {
+        memcpy(pos + header_part, value.data(), value_part);
+    }
+
+    WireFormat::WriteBytes(output, header + header_part, header_size - header_part);
+    WireFormat::WriteBytes(output, value.data() + value_part, value.size() - value_part);
+}
+
 }
 
 namespace timeplus {
@@ -27,11 +123,37 @@ namespace timeplus {
 ColumnFixedString::ColumnFixedString(size_t n)
     : Column(Type::CreateString(n))
     , string_size_(n)
+    , data_(std::make_shared<std::string>())
 {
 }
 
 void ColumnFixedString::Reserve(size_t new_cap) {
-    data_.reserve(string_size_ * new_cap);
+    Detach();
+    data_->reserve(string_size_ * new_cap);
+}
+
+std::string_view ColumnFixedString::Data() const {
+    return shared_data_ ? std::string_view(shared_data_.get(), shared_size_) : std::string_view(*data_);
+}
+
+void ColumnFixedString::Detach() {
+    if (!shared_data_ && data_.use_count() == 1) {
+        return;
+    }
+
+    data_ = std::make_shared<std::string>(Data());
+    shared_data_.reset();
+    shared_size_ = 0;
+}
+
+void ColumnFixedString::Reset() {
+    if (data_.use_count() == 1) {
+        data_->clear();
+    } else {
+        data_ = std::make_shared<std::string>();
+    }
+    shared_data_.reset();
+    shared_size_ = 0;
 }
 
 void ColumnFixedString::Append(std::string_view str) {
@@ -41,44 +163,60 @@ void ColumnFixedString::Append(std::string_view str) {
                                  + std::to_string(str.size()) + " bytes.");
     }
 
-    if (data_.capacity() - data_.size() < str.size()) {
+    Detach();
+    auto& data = *data_;
+    if (data.capacity() - data.size() < str.size()) {
         // round up to the next block size
-        const auto new_size = (((data_.size() + string_size_) / DEFAULT_BLOCK_SIZE) + 1) * DEFAULT_BLOCK_SIZE;
-        data_.reserve(new_size);
+        const auto new_size = (((data.size() + string_size_) / DEFAULT_BLOCK_SIZE) + 1) * DEFAULT_BLOCK_SIZE;
+        data.reserve(new_size);
     }
 
-    data_.insert(data_.size(), str);
+    data.insert(data.size(), str);
     // Pad up to string_size_ with zeroes.
     if (str.size() < string_size_) {
         const auto padding_size = string_size_ - str.size();
-        data_.resize(data_.size() + padding_size, char(0));
+        data.resize(data.size() + padding_size, char(0));
     }
 }
 
 void ColumnFixedString::Clear() {
-    data_.clear();
+    Reset();
 }
 
 std::string_view ColumnFixedString::At(size_t n) const {
+    const auto data = Data();
     const auto pos = n * string_size_;
-    return std::string_view(&data_.at(pos), string_size_);
+    if (pos >= data.size()) {
+        throw std::out_of_range("ColumnFixedString::At: index " + std::to_string(n) + " is out of range");
+    }
+    return data.substr(pos, string_size_);
 }
 
 size_t ColumnFixedString::FixedSize() const {
        return string_size_;
 }
 
+std::string& ColumnFixedString::GetWritableRawData() {
+    Detach();
+    return *data_;
+}
+
 void ColumnFixedString::Append(ColumnRef column) {
     if (auto col = column->As<ColumnFixedString>()) {
         if (string_size_ == col->string_size_) {
-            data_.insert(data_.end(), col->data_.begin(), col->data_.end());
+            // Appended data may be this column's own, keep it alive in case Detach() releases it.
+            const auto shared = col->shared_data_;
+            const auto data = col->Data();
+            Detach();
+            data_->append(data.data(), data.size());
         }
     }
 }
 
 bool ColumnFixedString::LoadBody(InputStream * input, size_t rows) {
-    data_.resize(string_size_ * rows);
-    if (!WireFormat::ReadBytes(*input, &data_[0], data_.size())) {
+    Reset();
+    data_->resize(string_size_ * rows);
+    if (!WireFormat::ReadBytes(*input, &(*data_)[0], data_->size())) {
         return false;
     }
 
@@ -86,20 +224,35 @@ bool ColumnFixedString::LoadBody(InputStream * input, size_t rows) {
 }
 
 void ColumnFixedString::SaveBody(OutputStream* output) {
-    WireFormat::WriteBytes(*output, data_.data(), data_.size());
+    const auto data = Data();
+    WireFormat::WriteBytes(*output, data.data(), data.size());
 }
 
 size_t ColumnFixedString::Size() const {
-    return data_.size() / string_size_;
+    return Data().size() / string_size_;
+}
+
+size_t ColumnFixedString::ByteSize() const {
+    return Data().size();
+}
+
+size_t ColumnFixedString::AllocatedBytes() const {
+    return data_->capacity() + (shared_data_ ? shared_allocated_ : 0);
 }
 
 ColumnRef ColumnFixedString::Slice(size_t begin, size_t len) const {
     auto result = std::make_shared<ColumnFixedString>(string_size_);
 
-    if (begin < Size()) {
+    if (begin < Size() && len) {
         const auto b = begin * string_size_;
-        const auto l = len * string_size_;
-        result->data_ = data_.substr(b, std::min(data_.size() - b, l));
+        const auto l = std::min(Data().size() - b, len * string_size_);
+        // Only references are copied, so slicing is safe alongside other readers of the column.
+        const auto data = Data();
+        result->shared_data_ = shared_data_
+            ? std::shared_ptr<const char>(shared_data_, data.data() + b)
+            : std::shared_ptr<const char>(data_, data.data() + b);
+        result->shared_size_ = l;
+        result->shared_allocated_ = shared_data_ ? shared_allocated_ : data_->capacity();
     }
 
     return result;
@@ -113,12 +266,65 @@ void ColumnFixedString::Swap(Column& other) {
     auto & col = dynamic_cast<ColumnFixedString &>(other);
     std::swap(string_size_, col.string_size_);
     data_.swap(col.data_);
+    shared_data_.swap(col.shared_data_);
+    std::swap(shared_size_, col.shared_size_);
+    std::swap(shared_allocated_, col.shared_allocated_);
 }
 
 ItemView ColumnFixedString::GetItem(size_t index) const {
     return ItemView{Type::FixedString, this->At(index)};
 }
 
+StringBlockPool::StringBlockPool(size_t max_retained_bytes)
+    : max_retained_bytes_(max_retained_bytes)
+    , retained_bytes_(0)
+{
+}
+
+StringBlockPool::~StringBlockPool() = default;
+
+std::unique_ptr<char[]> StringBlockPool::Acquire(size_t min_capacity, size_t * capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = items_.rbegin(); it != items_.rend(); ++it) {
+        if (it->capacity >= min_capacity) {
+            auto data = std::move(it->data);
+            *capacity = it->capacity;
+            retained_bytes_ -= it->capacity;
+            items_.erase(std::next(it).base());
+
+            return data;
+        }
+    }
+
+    return nullptr;
+}
+
+void StringBlockPool::Release(std::unique_ptr<char[]> data, size_t capacity) {
+    if (!data) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (retained_bytes_ + capacity > max_retained_bytes_) {
+        return;
+    }
+
+    retained_bytes_ += capacity;
+    items_.push_back(Item{capacity, std::move(data)});
+}
+
+size_t StringBlockPool::RetainedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retained_bytes_;
+}
+
+void StringBlockPool::Purge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.clear();
+    retained_bytes_ = 0;
+}
+
 struct ColumnString::Block
 {
     using CharT = typename std::string::value_type;
@@ -129,6 +335,12 @@ struct ColumnString::Block
         data_(new CharT[capacity])
     {}
 
+    Block(std::unique_ptr<CharT[]> data, size_t capacity)
+        : size(0),
+        capacity(capacity),
+        data_(std::move(data))
+    {}
+
     inline auto GetAvailable() const {
         return capacity - size;
     }
@@ -157,24 +369,69 @@ struct ColumnString::Block
     std::unique_ptr<CharT[]> data_;
 };
 
+/** Storage blocks and stolen strings of a column.
+ *
+ *  Slices keep it alive, but never access it otherwise: the column is free to append to it,
+ *  since characters the slices point to are never moved or overwritten.
+ */
+struct ColumnString::Storage
+{
+    ~Storage() {
+        if (pool) {
+            for (auto & block : blocks) {
+                pool->Release(std::move(block.data_), block.capacity);
+            }
+        }
+    }
+
+    std::vector<Block> blocks;
+    std::deque<std::string> append_data;
+    std::shared_ptr<StringBlockPool> pool;
+    /// Storage of the column this one is a slice of, values may point there as well.
+    std::shared_ptr<const Storage> previous;
+};
+
 ColumnString::ColumnString()
     : Column(Type::CreateString())
+    , layout_(Layout::Default)
+    , shared_rows_(0)
+    , shared_chars_base_(0)
+    , shared_allocated_(0)
+    , storage_(std::make_shared<Storage>())
+    , shared_bytes_(0)
+    , next_block_size_(DEFAULT_BLOCK_SIZE)
 {
 }
 
+ColumnString::ColumnString(Layout layout)
+    : ColumnString()
+{
+    layout_ = layout;
+    if (layout_ == Layout::Compact) {
+        offsets_ = std::make_shared<std::vector<uint64_t>>();
+        chars_ = std::make_shared<std::vector<char>>();
+    }
+}
+
+ColumnString::ColumnString(std::shared_ptr<StringBlockPool> pool)
+    : ColumnString()
+{
+    SetBlockPool(std::move(pool));
+}
+
 ColumnString::ColumnString(size_t element_count)
-    : Column(Type::CreateString())
+    : ColumnString()
 {
     items_.reserve(element_count);
     // 16 is arbitrary number, assumption that string values are about ~256 bytes long.
-    blocks_.reserve(std::max<size_t>(1, element_count / 16));
+    storage_->blocks.reserve(std::max<size_t>(1, element_count / 16));
 }
 
 ColumnString::ColumnString(const std::vector<std::string>& data)
     : ColumnString()
 {
     items_.reserve(data.size());
-    blocks_.emplace_back(ComputeTotalSize(data));
+    storage_->blocks.emplace_back(ComputeTotalSize(data));
 
     for (const auto & s : data) {
         AppendUnsafe(s);
@@ -187,27 +444,117 @@ ColumnString::ColumnString(std::vector<std::string>&& data)
     items_.reserve(data.size());
 
     for (auto&& d : data) {
-        append_data_.emplace_back(std::move(d));
-        auto& last_data = append_data_.back();
+        auto& last_data = storage_->append_data.emplace_back(std::move(d));
         items_.emplace_back(std::string_view{ last_data.data(),last_data.length() });
     }
 }
 
-ColumnString::~ColumnString()
-{}
+ColumnString::~ColumnString() = default;
 
 void ColumnString::Reserve(size_t new_cap) {
+    if (layout_ == Layout::Compact) {
+        DetachCompact();
+        offsets_->reserve(new_cap);
+        return;
+    }
+
     items_.reserve(new_cap);
     // 16 is arbitrary number, assumption that string values are about ~256 bytes long.
-    blocks_.reserve(std::max<size_t>(1, new_cap / 16));
+    storage_->blocks.reserve(std::max<size_t>(1, new_cap / 16));
+}
+
+void ColumnString::SetBlockPool(std::shared_ptr<StringBlockPool> pool) {
+    pool_ = std::move(pool);
+    private_pool_.reset();
+    storage_->pool = pool_;
+}
+
+std::shared_ptr<StringBlockPool> ColumnString::GetBlockPool() const {
+    return pool_;
+}
+
+ColumnString::Layout ColumnString::GetLayout() const {
+    return layout_;
+}
+
+Span<const uint64_t> ColumnString::GetOffsets() const {
+    if (shared_offsets_) {
+        return Span<const uint64_t>(shared_offsets_.get(), shared_rows_);
+    }
+    return offsets_ ? Span<const uint64_t>(*offsets_) : Span<const uint64_t>();
+}
+
+uint64_t ColumnString::GetCharsBase() const {
+    return shared_offsets_ ? shared_chars_base_ : 0;
+}
+
+Span<const char> ColumnString::GetChars() const {
+    if (shared_offsets_) {
+        return Span<const char>(shared_chars_.get(), shared_offsets_.get()[shared_rows_ - 1] - shared_chars_base_);
+    }
+    return chars_ ? Span<const char>(*chars_) : Span<const char>();
+}
+
+size_t ColumnString::DataSize() const {
+    return layout_ == Layout::Compact ? GetChars().size() : ComputeTotalSize(items_);
+}
+
+const std::shared_ptr<StringBlockPool>& ColumnString::BlockPool() const {
+    return pool_ ? pool_ : private_pool_;
+}
+
+ColumnString::Block ColumnString::AcquireBlock(size_t min_capacity) {
+    const auto block_size = std::max(next_block_size_, min_capacity);
+    next_block_size_ = std::min(next_block_size_ * 2, MAX_BLOCK_SIZE);
+
+    if (const auto& pool = BlockPool()) {
+        // Prefer a pooled buffer of the intended size, smaller ones would split the data across many blocks.
+        size_t capacity = 0;
+        auto data = pool->Acquire(block_size, &capacity);
+        if (!data && block_size > min_capacity) {
+            data = pool->Acquire(min_capacity, &capacity);
+        }
+        if (data) {
+            return Block(std::move(data), capacity);
+        }
+    }
+
+    return Block(block_size);
+}
+
+void ColumnString::ReleaseBlocks(std::vector<Block>& blocks) {
+    if (const auto& pool = BlockPool()) {
+        for (auto & block : blocks) {
+            pool->Release(std::move(block.data_), block.capacity);
+        }
+    }
+    blocks.clear();
+}
+
+void ColumnString::ResetStorage() {
+    if (storage_.use_count() == 1) {
+        ReleaseBlocks(storage_->blocks);
+        storage_->append_data.clear();
+        storage_->previous.reset();
+    } else {
+        storage_ = std::make_shared<Storage>();
+    }
+    storage_->pool = BlockPool();
+    shared_bytes_ = 0;
 }
 
 void ColumnString::Append(std::string_view str) {
-    if (blocks_.size() == 0 || blocks_.back().GetAvailable() < str.length()) {
-        blocks_.emplace_back(std::max(DEFAULT_BLOCK_SIZE, str.size()));
+    if (layout_ == Layout::Compact) {
+        AppendCompact(str);
+        return;
     }
 
-    items_.emplace_back(blocks_.back().AppendUnsafe(str));
+    auto& blocks = storage_->blocks;
+    if (blocks.size() == 0 || blocks.back().GetAvailable() < str.length()) {
+        blocks.push_back(AcquireBlock(str.size()));
+    }
+
+    items_.emplace_back(blocks.back().AppendUnsafe(str));
 }
 
 void ColumnString::Append(const char* str) {
@@ -215,36 +562,143 @@ void ColumnString::Append(const char* str) {
 }
 
 void ColumnString::Append(std::string&& steal_value) {
-    append_data_.emplace_back(std::move(steal_value));
-    auto& last_data = append_data_.back();
+    if (layout_ == Layout::Compact) {
+        AppendCompact(steal_value);
+        return;
+    }
+
+    auto& last_data = storage_->append_data.emplace_back(std::move(steal_value));
     items_.emplace_back(std::string_view{ last_data.data(),last_data.length() });
 }
 
 void ColumnString::AppendNoManagedLifetime(std::string_view str) {
+    if (layout_ == Layout::Compact) {
+        AppendCompact(str);
+        return;
+    }
+
     items_.emplace_back(str);
 }
 
+void ColumnString::AppendCompact(std::string_view str) {
+    DetachCompact();
+    chars_->insert(chars_->end(), str.begin(), str.end());
+    offsets_->push_back(chars_->size());
+}
+
+void ColumnString::DetachCompact() {
+    if (!shared_offsets_ && offsets_.use_count() == 1 && chars_.use_count() == 1) {
+        return;
+    }
+
+    const auto offsets = GetOffsets();
+    const auto chars = GetChars();
+    const auto base = GetCharsBase();
+
+    auto new_offsets = std::make_shared<std::vector<uint64_t>>();
+    new_offsets->reserve(offsets.size());
+    for (const auto offset : offsets) {
+        new_offsets->push_back(offset - base);
+    }
+
+    chars_ = std::make_shared<std::vector<char>>(chars.begin(), chars.end());
+    offsets_ = std::move(new_offsets);
+    shared_offsets_.reset();
+    shared_chars_.reset();
+    shared_rows_ = 0;
+    shared_chars_base_ = 0;
+}
+
+void ColumnString::ResetCompact() {
+    if (offsets_.use_count() == 1 && chars_.use_count() == 1) {
+        offsets_->clear();
+        chars_->clear();
+    } else {
+        offsets_ = std::make_shared<std::vector<uint64_t>>();
+        chars_ = std::make_shared<std::vector<char>>();
+    }
+    shared_offsets_.reset();
+    shared_chars_.reset();
+    shared_rows_ = 0;
+    shared_chars_base_ = 0;
+}
+
 void ColumnString::AppendUnsafe(std::string_view str) {
-    items_.emplace_back(blocks_.back().AppendUnsafe(str));
+    items_.emplace_back(storage_->blocks.back().AppendUnsafe(str));
 }
 
 void ColumnString::Clear() {
+    if (layout_ == Layout::Compact) {
+        ResetCompact();
+        return;
+    }
+
+    // Refilling the column likely takes about as much data as it has now: allocate blocks of that size
+    // and, without a pool, retain that many blocks (if not shared with slices) for reuse.
+    size_t used_bytes = 0;
+    size_t block_bytes = 0;
+    for (const auto & block : storage_->blocks) {
+        used_bytes += block.size;
+        block_bytes += block.capacity;
+    }
+    next_block_size_ = std::clamp(used_bytes, DEFAULT_BLOCK_SIZE, MAX_BLOCK_SIZE);
+    if (!pool_) {
+        private_pool_ = std::make_shared<StringBlockPool>(block_bytes);
+    }
+
     items_.clear();
-    blocks_.clear();
-    append_data_.clear();
+    ResetStorage();
 }
 
 std::string_view ColumnString::At(size_t n) const {
+    if (layout_ == Layout::Compact) {
+        const auto offsets = GetOffsets();
+        if (n >= offsets.size()) {
+            throw std::out_of_range("ColumnString::At: index " + std::to_string(n) + " is out of range");
+        }
+        const auto base = GetCharsBase();
+        const auto begin = (n == 0 ? base : offsets[n - 1]) - base;
+        return std::string_view(GetChars().data() + begin, offsets[n] - base - begin);
+    }
+
     return items_.at(n);
 }
 
 void ColumnString::Append(ColumnRef column) {
     if (auto col = column->As<ColumnString>()) {
-        const auto total_size = ComputeTotalSize(col->items_);
+        if (layout_ == Layout::Compact) {
+            if (col->layout_ == Layout::Compact) {
+                // Rows to append may be this column's own: holding them makes DetachCompact() copy rather than
+                // modify them (as it does if `column` is a slice of this one).
+                const auto offsets_storage = col->offsets_;
+                const auto chars_storage = col->chars_;
+                const auto offsets = col->GetOffsets();
+                const auto chars = col->GetChars();
+                const auto base = col->GetCharsBase();
+
+                DetachCompact();
+                const uint64_t shift = chars_->size();
+                chars_->insert(chars_->end(), chars.begin(), chars.end());
+                offsets_->reserve(offsets_->size() + offsets.size());
+                for (const auto offset : offsets) {
+                    offsets_->push_back(shift + (offset - base));
+                }
+            } else {
+                DetachCompact();
+                chars_->reserve(chars_->size() + col->DataSize());
+                for (size_t i = 0; i < col->Size(); ++i) {
+                    AppendCompact((*col)[i]);
+                }
+            }
+            return;
+        }
+
+        const auto total_size = col->DataSize();
 
         // TODO: fill up existing block with some items and then add a new one for the rest of items
-        if (blocks_.size() == 0 || blocks_.back().GetAvailable() < total_size)
-            blocks_.emplace_back(std::max(DEFAULT_BLOCK_SIZE, total_size));
+        auto& blocks = storage_->blocks;
+        if (blocks.size() == 0 || blocks.back().GetAvailable() < total_size)
+            blocks.push_back(AcquireBlock(total_size));
 
         // Intentionally not doing items_.reserve() since that cripples performance.
         for (size_t i = 0; i < column->Size(); ++i) {
@@ -254,76 +708,181 @@ void ColumnString::Append(ColumnRef column) {
 }
 
 bool ColumnString::LoadBody(InputStream* input, size_t rows) {
+    if (layout_ == Layout::Compact) {
+        return LoadBodyCompact(input, rows);
+    }
+
     if (rows == 0) {
         items_.clear();
-        blocks_.clear();
+        ResetStorage();
 
         return true;
     }
 
     decltype(items_) new_items;
-    decltype(blocks_) new_blocks;
+    std::vector<Block> new_blocks;
 
     new_items.reserve(rows);
 
-    // Suboptimzal if the first row string is >DEFAULT_BLOCK_SIZE, but that must be a very rare case.
-    Block * block = &new_blocks.emplace_back(DEFAULT_BLOCK_SIZE);
-
-    for (size_t i = 0; i < rows; ++i) {
-        uint64_t len;
-        if (!WireFormat::ReadUInt64(*input, &len))
-            return false;
+    // Suboptimzal if the first row string is larger than the block, but that must be a very rare case.
+    Block * block = &new_blocks.emplace_back(AcquireBlock(0));
 
+    const bool loaded = ReadStrings(input, rows, [&] (size_t len) {
         if (len > block->GetAvailable())
-            block = &new_blocks.emplace_back(std::max<size_t>(DEFAULT_BLOCK_SIZE, len));
-
-        if (!WireFormat::ReadBytes(*input, block->GetCurrentWritePos(), len))
-            return false;
+            block = &new_blocks.emplace_back(AcquireBlock(len));
 
+        const auto pos = block->GetCurrentWritePos();
         new_items.emplace_back(block->ConsumeTailAsStringViewUnsafe(len));
+        return pos;
+    });
+
+    if (!loaded) {
+        ReleaseBlocks(new_blocks);
+        return false;
     }
 
     items_.swap(new_items);
-    blocks_.swap(new_blocks);
+    ResetStorage();
+    storage_->blocks.swap(new_blocks);
+
+    return true;
+}
+
+bool ColumnString::LoadBodyCompact(InputStream* input, size_t rows) {
+    std::vector<uint64_t> new_offsets(rows);
+    std::vector<char> new_chars;
+    // Previous load is the best guess for the size of this one.
+    new_chars.reserve(chars_->capacity());
+
+    size_t row = 0;
+    const bool loaded = ReadStrings(input, rows, [&] (size_t len) {
+        const auto pos = new_chars.size();
+        new_chars.resize(pos + len);
+        new_offsets[row++] = new_chars.size();
+        return new_chars.data() + pos;
+    });
+
+    if (!loaded)
+        return false;
+
+    ResetCompact();
+    offsets_->swap(new_offsets);
+    chars_->swap(new_chars);
 
     return true;
 }
 
 void ColumnString::SaveBody(OutputStream* output) {
-    for (const auto & item : items_) {
-        WireFormat::WriteString(*output, item);
+    auto save = [this] (auto& out) {
+        if (layout_ == Layout::Compact) {
+            const auto chars = GetChars();
+            const auto base = GetCharsBase();
+            uint64_t begin = 0;
+            for (const auto offset : GetOffsets()) {
+                const auto end = offset - base;
+                WriteString(out, std::string_view(chars.data() + begin, end - begin));
+                begin = end;
+            }
+            return;
+        }
+
+        for (const auto & item : items_) {
+            WriteString(out, item);
+        }
+    };
+
+    if (auto zero_copy = dynamic_cast<ZeroCopyOutput*>(output)) {
+        save(*zero_copy);
+    } else {
+        save(*output);
     }
 }
 
 size_t ColumnString::Size() const {
-    return items_.size();
+    return layout_ == Layout::Compact ? GetOffsets().size() : items_.size();
 }
 
-ColumnRef ColumnString::Slice(size_t begin, size_t len) const {
-    auto result = std::make_shared<ColumnString>();
+size_t ColumnString::ByteSize() const {
+    if (layout_ == Layout::Compact) {
+        return GetOffsets().size() * sizeof(uint64_t) + GetChars().size();
+    }
+    return items_.size() * sizeof(std::string_view) + DataSize();
+}
 
-    if (begin < items_.size()) {
-        len = std::min(len, items_.size() - begin);
-        result->items_.reserve(len);
+size_t ColumnString::AllocatedBytes() const {
+    if (layout_ == Layout::Compact) {
+        return offsets_->capacity() * sizeof(uint64_t) + chars_->capacity()
+            + (shared_offsets_ ? shared_allocated_ : 0);
+    }
+
+    return items_.capacity() * sizeof(std::string_view)
+        + StorageBytes(storage_->blocks, storage_->append_data)
+        + shared_bytes_
+        + (private_pool_ ? private_pool_->RetainedBytes() : 0);
+}
 
-        result->blocks_.emplace_back(ComputeTotalSize(items_, begin, len));
-        for (size_t i = begin; i < begin + len; ++i) {
-            result->Append(items_[i]);
+ColumnRef ColumnString::Slice(size_t begin, size_t len) const {
+    if (layout_ == Layout::Compact) {
+        auto result = std::make_shared<ColumnString>(Layout::Compact);
+
+        const auto offsets = GetOffsets();
+        if (begin < offsets.size() && len) {
+            len = std::min(len, offsets.size() - begin);
+            const auto base = GetCharsBase();
+            const auto chars_begin = begin == 0 ? base : offsets[begin - 1];
+            const auto chars = GetChars().data() + (chars_begin - base);
+
+            // Only references are copied, so slicing is safe alongside other readers of the column.
+            if (shared_offsets_) {
+                result->shared_offsets_ = std::shared_ptr<const uint64_t>(shared_offsets_, offsets.data() + begin);
+                result->shared_chars_ = std::shared_ptr<const char>(shared_chars_, chars);
+                result->shared_allocated_ = shared_allocated_;
+            } else {
+                result->shared_offsets_ = std::shared_ptr<const uint64_t>(offsets_, offsets.data() + begin);
+                result->shared_chars_ = std::shared_ptr<const char>(chars_, chars);
+                result->shared_allocated_ = offsets_->capacity() * sizeof(uint64_t) + chars_->capacity();
+            }
+            result->shared_rows_ = len;
+            result->shared_chars_base_ = chars_begin;
         }
+
+        return result;
+    }
+
+    auto result = std::make_shared<ColumnString>(pool_);
+
+    if (begin < items_.size() && len) {
+        len = std::min(len, items_.size() - begin);
+        result->items_.assign(items_.begin() + begin, items_.begin() + begin + len);
+        // Only references are copied, so slicing is safe alongside other readers of the column.
+        result->storage_->previous = storage_;
+        result->shared_bytes_ = StorageBytes(storage_->blocks, storage_->append_data) + shared_bytes_;
     }
 
     return result;
 }
 
 ColumnRef ColumnString::CloneEmpty() const {
-    return std::make_shared<ColumnString>();
+    if (layout_ == Layout::Compact) {
+        return std::make_shared<ColumnString>(Layout::Compact);
+    }
+
+    return std::make_shared<ColumnString>(pool_);
 }
 
 void ColumnString::Swap(Column& other) {
     auto & col = dynamic_cast<ColumnString &>(other);
+    std::swap(layout_, col.layout_);
+    offsets_.swap(col.offsets_);
+    chars_.swap(col.chars_);
+    shared_offsets_.swap(col.shared_offsets_);
+    std::swap(shared_rows_, col.shared_rows_);
+    shared_chars_.swap(col.shared_chars_);
+    std::swap(shared_chars_base_, col.shared_chars_base_);
+    std::swap(shared_allocated_, col.shared_allocated_);
     items_.swap(col.items_);
-    blocks_.swap(col.blocks_);
-    append_data_.swap(col.append_data_);
+    storage_.swap(col.storage_);
+    std::swap(shared_bytes_, col.shared_bytes_);
 }
 
 ItemView ColumnString::GetItem(size_t index) const {
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
 
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
-#include <deque>
 
 namespace timeplus {
 
@@ -42,6 +45,10 @@ public:
     /// Returns the max size of the fixed string
     size_t FixedSize() const;
 
+    /// Contents of all rows back to back, for bulk writes; its size must be kept a multiple of FixedSize().
+    /// Data shared with slices is copied first, so call it again after Slice() instead of keeping the reference.
+    std::string& GetWritableRawData();
+
 public:
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override;
@@ -58,16 +65,75 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
-    /// Makes slice of the current column.
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
+    /// Makes slice of the current column, which shares memory with this one instead of copying it.
+    /// Whichever column is modified afterwards copies its data first (copy-on-write).
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
     void Swap(Column& other) override;
 
     ItemView GetItem(size_t) const override;
 
+private:
+    /// Contents of all rows back to back, either own or shared.
+    std::string_view Data() const;
+    /// Makes data_ hold the rows and be referenced by this column only.
+    void Detach();
+    /// Drops all rows, keeping capacity of data_ unless slices refer to it.
+    void Reset();
+
 private:
     size_t string_size_;
-    std::string data_;
+    /// Own rows, referenced by slices as well (hence shared_ptr), never null.
+    std::shared_ptr<std::string> data_;
+    /// Rows of another column this one is a slice of, used instead of data_ until the column is modified.
+    std::shared_ptr<const char> shared_data_;
+    size_t shared_size_ = 0;
+    /// Size of the whole allocation shared_data_ points into.
+    size_t shared_allocated_ = 0;
+};
+
+/**
+ * Pool of character buffers that ColumnString instances use for their storage blocks.
+ *
+ * Blocks of a cleared or destroyed column are returned to the pool and handed out again
+ * on subsequent appends, so producers that refill columns batch after batch do not churn malloc/free.
+ * A single pool may be shared by several columns (e.g. all string columns of a Block), it is thread-safe.
+ */
+class StringBlockPool {
+public:
+    static constexpr size_t DEFAULT_MAX_RETAINED_BYTES = 64 * 1024 * 1024;
+
+    explicit StringBlockPool(size_t max_retained_bytes = DEFAULT_MAX_RETAINED_BYTES);
+    ~StringBlockPool();
+
+    /// Takes a buffer of at least `min_capacity` bytes out of the pool, returns nullptr if there is none.
+    std::unique_ptr<char[]> Acquire(size_t min_capacity, size_t * capacity);
+
+    /// Puts buffer back to the pool, buffer is freed if pool already retains max_retained_bytes.
+    void Release(std::unique_ptr<char[]> data, size_t capacity);
+
+    /// Total size of buffers currently kept in the pool.
+    size_t RetainedBytes() const;
+
+    /// Frees all retained buffers.
+    void Purge();
+
+private:
+    struct Item {
+        size_t capacity;
+        std::unique_ptr<char[]> data;
+    };
+
+    const size_t max_retained_bytes_;
+    mutable std::mutex mutex_;
+    std::vector<Item> items_;
+    size_t retained_bytes_;
 };
 
 /**
@@ -78,18 +144,50 @@ public:
     // Type this column takes as argument of Append and returns with At() and operator[]
     using ValueType = std::string_view;
 
+    /// How values are stored in memory, does not affect serialization.
+    enum class Layout {
+        /// A string_view per row pointing into storage blocks, values passed by rvalue or
+        /// with AppendNoManagedLifetime() are not copied.
+        Default,
+        /// Same as server's representation: end offset per row and one contiguous buffer of chars,
+        /// every value is copied.
+        Compact,
+    };
+
     ColumnString();
+    explicit ColumnString(Layout layout);
     ~ColumnString();
 
     explicit ColumnString(size_t element_count);
     explicit ColumnString(const std::vector<std::string> & data);
     explicit ColumnString(std::vector<std::string>&& data);
+    explicit ColumnString(std::shared_ptr<StringBlockPool> pool);
     ColumnString& operator=(const ColumnString&) = delete;
     ColumnString(const ColumnString&) = delete;
 
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
 
+    /** Set pool to recycle storage blocks through, it may be shared with other columns.
+     *  Without a pool, Clear() still retains blocks for reuse by this column only,
+     *  as many as the cleared rows took (see AllocatedBytes()).
+     */
+    void SetBlockPool(std::shared_ptr<StringBlockPool> pool);
+    std::shared_ptr<StringBlockPool> GetBlockPool() const;
+
+    Layout GetLayout() const;
+
+    /** End offset of each row, only populated with Layout::Compact.
+     *
+     *  Slice shares offsets with the column it was made from, so they are relative to GetCharsBase():
+     *  row n is GetChars() from (n == 0 ? 0 : GetOffsets()[n - 1] - GetCharsBase()) to GetOffsets()[n] - GetCharsBase().
+     */
+    Span<const uint64_t> GetOffsets() const;
+    /// Offset of the first character of GetChars(), non-zero for slices only.
+    uint64_t GetCharsBase() const;
+    /// Contents of all rows back to back, only populated with Layout::Compact.
+    Span<const char> GetChars() const;
+
     /// Appends one element to the column.
     void Append(std::string_view str);
 
@@ -119,27 +217,78 @@ public:
     /// Saves column data to output stream.
     void SaveBody(OutputStream* output) override;
 
-    /// Clear column data .
+    /// Clear column data, storage blocks are kept for refilling the column (see SetBlockPool()).
+    /// Blocks allocated afterwards are sized for as much data as the cleared rows had.
     void Clear() override;
 
     /// Returns count of rows in the column.
     size_t Size() const override;
 
-    /// Makes slice of the current column.
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes, including blocks retained by Clear() without a pool.
+    size_t AllocatedBytes() const override;
+
+    /** Makes slice of the current column.
+     *
+     *  Slice refers to memory of this column instead of copying the values.
+     *  With Layout::Default, storage blocks stay alive while any of the columns needs them. Characters are never
+     *  overwritten once appended, so both columns may keep appending (each to own blocks) without affecting the other one.
+     *  With Layout::Compact, whichever column is modified afterwards copies its offsets and chars first (copy-on-write).
+     */
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
     void Swap(Column& other) override;
     ItemView GetItem(size_t) const override;
 
 private:
+    struct Block;
+    struct Storage;
+
     void AppendUnsafe(std::string_view);
+    void AppendCompact(std::string_view);
+    /// Pool set with SetBlockPool(), or the one of this column only, made by Clear().
+    const std::shared_ptr<StringBlockPool>& BlockPool() const;
+    Block AcquireBlock(size_t min_capacity);
+    void ReleaseBlocks(std::vector<Block>& blocks);
+    /// Drops storage of all values, recycling blocks unless slices refer to them.
+    void ResetStorage();
+
+    /// Makes offsets_ and chars_ hold the rows and be referenced by this column only.
+    void DetachCompact();
+    /// Drops all rows, keeping capacity of offsets_ and chars_ unless slices refer to them.
+    void ResetCompact();
+    bool LoadBodyCompact(InputStream* input, size_t rows);
+    size_t DataSize() const;
 
 private:
-    struct Block;
-
+    Layout layout_;
+
+    // Layout::Compact
+    /// Own rows, referenced by slices as well (hence shared_ptr), never null with Layout::Compact.
+    std::shared_ptr<std::vector<uint64_t>> offsets_;
+    std::shared_ptr<std::vector<char>> chars_;
+    /// Rows of another column this one is a slice of, used instead of offsets_ and chars_ until the column is modified.
+    std::shared_ptr<const uint64_t> shared_offsets_;
+    size_t shared_rows_;
+    std::shared_ptr<const char> shared_chars_;
+    uint64_t shared_chars_base_;
+    /// Size of the whole allocations shared_offsets_ and shared_chars_ point into, in bytes.
+    size_t shared_allocated_;
+
+    // Layout::Default
     std::vector<std::string_view> items_;
-    std::vector<Block> blocks_;
-    std::deque<std::string> append_data_;
+    /// Memory items_ point to, referenced by slices as well (hence shared_ptr), never null.
+    std::shared_ptr<Storage> storage_;
+    /// Memory held by storage of the column this one is a slice of, as of slicing.
+    size_t shared_bytes_;
+    std::shared_ptr<StringBlockPool> pool_;
+    /// Retains blocks of the last cleared rows when there is no pool_.
+    std::shared_ptr<StringBlockPool> private_pool_;
+    /// Starts at the data size of the last cleared rows, then grows with the amount of data appended,
+    /// so batches end up in few large blocks.
+    size_t next_block_size_;
 };
 
 }
@@ -41,6 +41,22 @@ size_t ColumnTuple::Size() const {
     return columns_.empty() ? 0 : columns_[0]->Size();
 }
 
+size_t ColumnTuple::ByteSize() const {
+    size_t result = 0;
+    for (const auto & column : columns_) {
+        result += column->ByteSize();
+    }
+    return result;
+}
+
+size_t ColumnTuple::AllocatedBytes() const {
+    size_t result = 0;
+    for (const auto & column : columns_) {
+        result += column->AllocatedBytes();
+    }
+    return result;
+}
+
 ColumnRef ColumnTuple::Slice(size_t begin, size_t len) const {
     std::vector<ColumnRef> sliced_columns;
     sliced_columns.reserve(columns_.size());
@@ -95,7 +111,9 @@ void ColumnTuple::SaveBody(OutputStream* output) {
 }
 
 void ColumnTuple::Clear() {
-    columns_.clear();
+    for (auto & column : columns_) {
+        column->Clear();
+    }
 }
 
 void ColumnTuple::Swap(Column& other) {
@@ -3,6 +3,12 @@
 #include "column.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace timeplus {
@@ -50,6 +56,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t, size_t) const override;
     ColumnRef CloneEmpty() const override;
@@ -86,6 +98,71 @@ public:
         AppendTuple(std::move(value));
     }
 
+    /// Read-only contiguous arrays of items, one per element, see GetSpans() and AppendRows().
+    using Spans = std::tuple<Span<const std::decay_t<decltype(std::declval<Columns>().At(0))>>...>;
+
+    /** Appends rows given as parallel arrays, one per element: i-th row is made of i-th items of all arrays.
+     *  Throws ValidationError, appending nothing, if arrays differ in size.
+     *  If appending to an element column throws, rows appended to other elements are dropped before rethrowing.
+     */
+    void AppendRows(const Spans& items) {
+        AppendRows(items, nullptr, 1);
+    }
+
+    /// Same, but for wide tuples and many rows elements are filled with (up to one per element) `workers` tasks
+    /// run by `executor`, each task filling its own subset of elements.
+    void AppendRows(const Spans& items, const ParallelExecutor& executor, size_t workers) {
+        CheckRowsCount(items, std::index_sequence_for<Columns...>{});
+
+        const auto sizes = ElementSizes(std::index_sequence_for<Columns...>{});
+        try {
+            workers = std::min(workers, sizeof...(Columns));
+            if (!executor || workers <= 1) {
+                AppendElements(items, 0, 1, std::index_sequence_for<Columns...>{});
+                return;
+            }
+
+            std::vector<std::exception_ptr> errors(workers);
+
+            executor(workers, [&] (size_t worker) {
+                try {
+                    AppendElements(items, worker, workers, std::index_sequence_for<Columns...>{});
+                } catch (...) {
+                    errors[worker] = std::current_exception();
+                }
+            });
+
+            for (const auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        } catch (...) {
+            TruncateElements(sizes, std::index_sequence_for<Columns...>{});
+            throw;
+        }
+    }
+
+    /// Returns items of all elements as spans pointing directly into column data,
+    /// available when every element column stores its items as a contiguous array (i.e. numbers).
+    inline Spans GetSpans() const { return GetSpans(std::index_sequence_for<Columns...>{}); }
+
+    /// Returns typed columns of all elements, without shared_ptr copies.
+    inline std::tuple<const Columns&...> GetColumns() const {
+        return std::apply([](const auto&... columns) { return std::tuple<const Columns&...>(*columns...); }, typed_columns_);
+    }
+
+    /// Returns typed column of the tuple element with given index.
+    template <size_t index>
+    inline auto& GetColumn() {
+        return *std::get<index>(typed_columns_);
+    }
+
+    template <size_t index>
+    inline const auto& GetColumn() const {
+        return *std::get<index>(typed_columns_);
+    }
+
     /** Create a ColumnTupleT from a ColumnTuple, without copying data and offsets, but by
      * 'stealing' those from `col`.
      *
@@ -120,6 +197,42 @@ public:
     }
 
 private:
+    template <size_t... I>
+    inline void CheckRowsCount([[maybe_unused]] const Spans& items, std::index_sequence<I...>) const {
+        const size_t sizes[] = {std::get<I>(items).size()..., 0};
+        for (size_t i = 1; i < sizeof...(I); ++i) {
+            if (sizes[i] != sizes[0]) {
+                throw ValidationError("Tuple element " + std::to_string(i) + " has " + std::to_string(sizes[i])
+                    + " items, but element 0 has " + std::to_string(sizes[0]));
+            }
+        }
+    }
+
+    template <size_t... I>
+    inline std::array<size_t, sizeof...(Columns)> ElementSizes(std::index_sequence<I...>) const {
+        return {std::get<I>(typed_columns_)->Size()...};
+    }
+
+    /// Drops items appended to element columns after their `sizes`.
+    template <size_t... I>
+    inline void TruncateElements([[maybe_unused]] const std::array<size_t, sizeof...(Columns)>& sizes, std::index_sequence<I...>) {
+        (details::TruncateColumn(*std::get<I>(typed_columns_), sizes[I]), ...);
+    }
+
+    /// Appends items of elements with index `worker` modulo `workers`.
+    template <size_t... I>
+    inline void AppendElements([[maybe_unused]] const Spans& items, [[maybe_unused]] size_t worker,
+                               [[maybe_unused]] size_t workers, std::index_sequence<I...>) {
+        ((I % workers == worker ? details::AppendItems(*std::get<I>(typed_columns_), std::get<I>(items)) : void()), ...);
+    }
+
+    template <size_t... I>
+    inline Spans GetSpans(std::index_sequence<I...>) const {
+        static_assert((details::HasSpanData<Columns, std::decay_t<decltype(std::declval<Columns>().At(0))>>::value && ...),
+            "All tuple elements must store items as contiguous arrays");
+        return Spans{std::get<I>(typed_columns_)->GetData()...};
+    }
+
     template <typename T, size_t index = std::tuple_size_v<T>>
     inline void AppendTuple([[maybe_unused]] T value) {
         static_assert(index <= std::tuple_size_v<T>);
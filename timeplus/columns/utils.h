@@ -1,11 +1,20 @@
 #pragma once
 
+#include "../base/span.h"
+
 #include <algorithm>
+#include <functional>
 #include <vector>
 #include <memory>
+#include <type_traits>
 
 namespace timeplus {
 
+/** Runs `count` independent tasks, task(0) ... task(count - 1), possibly in parallel, and returns once all of them are done.
+ *  Lets the library use threads the application already has, i.e. its thread pool.
+ */
+using ParallelExecutor = std::function<void(size_t count, const std::function<void(size_t)>& task)>;
+
 template <typename T>
 std::vector<T> SliceVector(const std::vector<T>& vec, size_t begin, size_t len) {
     std::vector<T> result;
@@ -38,4 +47,44 @@ inline std::shared_ptr<T> WrapColumn(ColumnRef&& column) {
     }
 }
 
+namespace details {
+
+/// Whether ColumnType can append a contiguous array of T at once.
+template <typename ColumnType, typename T, typename = void>
+struct HasAppendRange : std::false_type {};
+
+template <typename ColumnType, typename T>
+struct HasAppendRange<ColumnType, T, std::void_t<decltype(std::declval<ColumnType&>().AppendRange(std::declval<const T*>(), size_t{}))>>
+    : std::true_type {};
+
+/// Whether ColumnType stores its items as a contiguous array of T, returned by GetData().
+template <typename ColumnType, typename T, typename = void>
+struct HasSpanData : std::false_type {};
+
+template <typename ColumnType, typename T>
+struct HasSpanData<ColumnType, T, std::enable_if_t<std::is_same_v<decltype(std::declval<const ColumnType&>().GetData()), Span<const T>>>>
+    : std::true_type {};
+
+/// Appends `items` to `column`, at once where the column supports that.
+template <typename ColumnType, typename T>
+inline void AppendItems(ColumnType& column, Span<const T> items) {
+    if constexpr (HasAppendRange<ColumnType, T>::value) {
+        column.AppendRange(items.data(), items.size());
+    } else {
+        for (const auto& item : items) {
+            column.Append(item);
+        }
+    }
+}
+
+/// Drops items appended to `column` after its first `size` ones, i.e. to roll back a failed append.
+template <typename ColumnType>
+inline void TruncateColumn(ColumnType& column, size_t size) {
+    if (column.Size() > size) {
+        column.Swap(*column.Slice(0, size));
+    }
+}
+
+}
+
 }
@@ -1,11 +1,87 @@
 #include "uuid.h"
+#include "string.h"
 #include "utils.h"
+#include "../base/hex.h"
 #include "../exceptions.h"
 
+#include <cstring>
 #include <stdexcept>
 
 namespace timeplus {
 
+namespace {
+
+/// "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+constexpr size_t UUID_TEXT_SIZE = 36;
+/// Sizes of dash-separated groups of hex digits.
+constexpr size_t UUID_GROUPS[] = {8, 4, 4, 4, 12};
+
+/// Values are stored as two 64-bit halves, the first one holds the first 16 hex digits.
+inline uint64_t LoadBigEndian(const uint8_t* bytes) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        result = result << 8 | bytes[i];
+    }
+    return result;
+}
+
+inline void StoreBigEndian(uint64_t value, uint8_t* bytes) {
+    for (size_t i = 8; i-- > 0; value >>= 8) {
+        bytes[i] = static_cast<uint8_t>(value);
+    }
+}
+
+bool ParseUUID(std::string_view text, uint64_t* halves) {
+    if (text.size() != UUID_TEXT_SIZE) {
+        return false;
+    }
+
+    // Hex digits without dashes, decoded all at once.
+    char digits[32];
+    size_t text_pos = 0, digits_pos = 0;
+    for (const auto group_size : UUID_GROUPS) {
+        if (text_pos != 0) {
+            if (text[text_pos] != '-') {
+                return false;
+            }
+            ++text_pos;
+        }
+        std::memcpy(digits + digits_pos, text.data() + text_pos, group_size);
+        text_pos += group_size;
+        digits_pos += group_size;
+    }
+
+    uint8_t bytes[16];
+    if (!DecodeHex(digits, sizeof(bytes), bytes)) {
+        return false;
+    }
+
+    halves[0] = LoadBigEndian(bytes);
+    halves[1] = LoadBigEndian(bytes + 8);
+    return true;
+}
+
+void FormatUUID(const uint64_t* halves, char* text) {
+    uint8_t bytes[16];
+    StoreBigEndian(halves[0], bytes);
+    StoreBigEndian(halves[1], bytes + 8);
+
+    char digits[32];
+    EncodeHex(bytes, sizeof(bytes), digits);
+
+    size_t text_pos = 0, digits_pos = 0;
+    for (const auto group_size : UUID_GROUPS) {
+        if (text_pos != 0) {
+            text[text_pos++] = '-';
+        }
+        std::memcpy(text + text_pos, digits + digits_pos, group_size);
+        text_pos += group_size;
+        digits_pos += group_size;
+    }
+}
+
+}
+
 ColumnUUID::ColumnUUID()
     : Column(Type::CreateUUID())
     , data_(std::make_shared<ColumnUInt64>())
@@ -36,6 +112,40 @@ const UUID ColumnUUID::At(size_t n) const {
     return UUID({data_->At(n * 2), data_->At(n * 2 + 1)});
 }
 
+std::string ColumnUUID::AsString(size_t n) const {
+    const auto data = data_->GetData();
+    if (n >= Size()) {
+        throw std::out_of_range("ColumnUUID::AsString: index " + std::to_string(n) + " is out of range");
+    }
+
+    std::string result(UUID_TEXT_SIZE, '\0');
+    FormatUUID(data.data() + n * 2, result.data());
+    return result;
+}
+
+void ColumnUUID::AppendStrings(Span<const std::string_view> values) {
+    auto & data = data_->GetWritableData();
+    const auto initial_size = data.size();
+    data.resize(initial_size + values.size() * 2);
+
+    uint64_t* output = data.data() + initial_size;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!ParseUUID(values[i], output + i * 2)) {
+            data.resize(initial_size);
+            throw ValidationError("invalid UUID format: " + std::string(values[i]));
+        }
+    }
+}
+
+void ColumnUUID::ToStrings(ColumnString& output) const {
+    const auto data = data_->GetData();
+    char text[UUID_TEXT_SIZE];
+    for (size_t i = 0; i < data.size(); i += 2) {
+        FormatUUID(data.data() + i, text);
+        output.Append(std::string_view(text, sizeof(text)));
+    }
+}
+
 void ColumnUUID::Reserve(size_t new_cap) {
     data_->Reserve(new_cap);
 }
@@ -58,6 +168,14 @@ size_t ColumnUUID::Size() const {
     return data_->Size() / 2;
 }
 
+size_t ColumnUUID::ByteSize() const {
+    return data_->ByteSize();
+}
+
+size_t ColumnUUID::AllocatedBytes() const {
+    return data_->AllocatedBytes();
+}
+
 ColumnRef ColumnUUID::Slice(size_t begin, size_t len) const {
     return std::make_shared<ColumnUUID>(data_->Slice(begin * 2, len * 2));
 }
@@ -4,8 +4,12 @@
 #include "column.h"
 #include "numeric.h"
 
+#include <string>
+#include <string_view>
+
 namespace timeplus {
 
+class ColumnString;
 
 /**
  * Represents a UUID column.
@@ -25,6 +29,16 @@ public:
     /// Returns element at given row number.
     inline const UUID operator [] (size_t n) const { return At(n); }
 
+    /// Returns element at given row number in text form, e.g. "61f0c404-5cb3-11e7-907b-a6006ad3dba0".
+    std::string AsString(size_t n) const;
+
+    /// Appends values in text form (hex digits of either case, with dashes at the usual positions).
+    /// Throws ValidationError, leaving the column unchanged, if any of them is malformed.
+    void AppendStrings(Span<const std::string_view> values);
+
+    /// Appends all values in text form to `output`.
+    void ToStrings(ColumnString& output) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -44,6 +58,12 @@ public:
     /// Returns count of rows in the column.
     size_t Size() const override;
 
+    /// Returns size of the column data in bytes.
+    size_t ByteSize() const override;
+
+    /// Returns amount of memory held by the column in bytes.
+    size_t AllocatedBytes() const override;
+
     /// Makes slice of the current column.
     ColumnRef Slice(size_t begin, size_t len) const override;
     ColumnRef CloneEmpty() const override;
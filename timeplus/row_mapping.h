@@ -0,0 +1,217 @@
+#pragma once
+
+#include "block.h"
+#include "columns/numeric.h"
+#include "columns/string.h"
+#include "columns/utils.h"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace timeplus {
+
+namespace details {
+
+/// Column used for a struct member when it is not given explicitly.
+template <typename T>
+struct DefaultColumnOf {
+    using Type = ColumnVector<T>;
+};
+
+template <>
+struct DefaultColumnOf<std::string> {
+    using Type = ColumnString;
+};
+
+template <typename T>
+struct IsColumnVector : std::false_type {};
+
+template <typename T>
+struct IsColumnVector<ColumnVector<T>> : std::true_type {};
+
+}
+
+/// Binding of a struct member to a named column, made by BindField().
+template <typename Struct, typename Member, typename ColumnType>
+struct FieldBinding {
+    using StructType = Struct;
+    using MemberType = Member;
+    using Column = ColumnType;
+
+    std::string name;
+    Member Struct::* member;
+    std::function<std::shared_ptr<ColumnType>()> create_column;
+};
+
+/** Binds struct member to column `name`.
+ *
+ *  By default numeric members are stored in ColumnVector of the very same type (so column type is
+ *  Type::CreateSimple<Member>()) and std::string members in ColumnString. Other column can be given explicitly:
+ *
+ *      BindField<ColumnLowCardinalityT<ColumnString>>("symbol", &Trade::symbol)
+ */
+template <typename ColumnType = void, typename Struct, typename Member>
+FieldBinding<Struct, Member, std::conditional_t<std::is_void_v<ColumnType>, typename details::DefaultColumnOf<Member>::Type, ColumnType>>
+BindField(std::string name, Member Struct::* member) {
+    using Column = std::conditional_t<std::is_void_v<ColumnType>, typename details::DefaultColumnOf<Member>::Type, ColumnType>;
+
+    return BindField<Column>(std::move(name), member, [] { return std::make_shared<Column>(); });
+}
+
+/// Binds struct member to column `name` created by `create_column`, i.e. for types with parameters like ColumnDateTime64.
+template <typename ColumnType, typename Struct, typename Member>
+FieldBinding<Struct, Member, ColumnType>
+BindField(std::string name, Member Struct::* member, std::function<std::shared_ptr<ColumnType>()> create_column) {
+    if constexpr (details::IsColumnVector<ColumnType>::value) {
+        static_assert(std::is_same_v<ColumnType, ColumnVector<Member>>,
+            "Numeric member must be bound to column of the same type, i.e. int64_t to ColumnInt64");
+    }
+
+    return FieldBinding<Struct, Member, ColumnType>{std::move(name), member, std::move(create_column)};
+}
+
+/** Mapping of a struct to a row of the block, used to insert data held in a vector of structs.
+ *
+ *  ToBlock() transposes rows into columns in chunks small enough to stay in cache,
+ *  so every struct is loaded from memory once no matter how many columns there are.
+ *  For large vectors (tens of thousands of rows) columns can be filled in parallel by caller's executor,
+ *  each task filling its own subset of columns.
+ */
+template <typename Struct, typename... Fields>
+class RowMapping {
+    static_assert(sizeof...(Fields) > 0, "RowMapping must have at least one field");
+    static_assert((std::is_same_v<Struct, typename Fields::StructType> && ...), "All fields must belong to the mapped struct");
+
+public:
+    static constexpr size_t COLUMN_COUNT = sizeof...(Fields);
+
+    explicit RowMapping(Fields... fields)
+        : fields_(std::move(fields)...)
+    {}
+
+    /// Fills columns on the calling thread.
+    Block ToBlock(const std::vector<Struct>& rows) const {
+        return ToBlock(rows.data(), rows.size(), nullptr, 1);
+    }
+
+    Block ToBlock(const Struct* rows, size_t count) const {
+        return ToBlock(rows, count, nullptr, 1);
+    }
+
+    /// Fills columns with (up to one per column) `workers` tasks run by `executor`.
+    Block ToBlock(const std::vector<Struct>& rows, const ParallelExecutor& executor, size_t workers) const {
+        return ToBlock(rows.data(), rows.size(), executor, workers);
+    }
+
+    Block ToBlock(const Struct* rows, size_t count, const ParallelExecutor& executor, size_t workers) const {
+        auto columns = CreateColumns(count, std::index_sequence_for<Fields...>{});
+
+        workers = std::min(workers, COLUMN_COUNT);
+        if (!executor || workers <= 1) {
+            Transpose(columns, rows, count, 0, 1);
+        } else {
+            std::vector<std::exception_ptr> errors(workers);
+
+            executor(workers, [&] (size_t worker) {
+                try {
+                    Transpose(columns, rows, count, worker, workers);
+                } catch (...) {
+                    errors[worker] = std::current_exception();
+                }
+            });
+
+            for (const auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        Block block(COLUMN_COUNT, count);
+        AppendColumns(block, columns, std::index_sequence_for<Fields...>{});
+        return block;
+    }
+
+private:
+    using Columns = std::tuple<std::shared_ptr<typename Fields::Column>...>;
+
+    /// Rows appended to all columns before moving to the next chunk, sized so the chunk of structs stays in L1/L2.
+    static constexpr size_t ROWS_PER_CHUNK = 256;
+
+    template <size_t... I>
+    Columns CreateColumns(size_t count, std::index_sequence<I...>) const {
+        Columns columns{std::get<I>(fields_).create_column()...};
+        (std::get<I>(columns)->Reserve(count), ...);
+        return columns;
+    }
+
+    /// Fills columns with index `worker` modulo `workers`.
+    void Transpose(Columns& columns, const Struct* rows, size_t count, size_t worker, size_t workers) const {
+        for (size_t begin = 0; begin < count; begin += ROWS_PER_CHUNK) {
+            const size_t end = std::min(count, begin + ROWS_PER_CHUNK);
+            TransposeChunk(columns, rows, begin, end, worker, workers, std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    template <size_t... I>
+    inline void TransposeChunk(Columns& columns, const Struct* rows, size_t begin, size_t end,
+                               size_t worker, size_t workers, std::index_sequence<I...>) const {
+        ((I % workers == worker ? TransposeColumn<I>(columns, rows, begin, end) : void()), ...);
+    }
+
+    template <size_t I>
+    inline void TransposeColumn(Columns& columns, const Struct* rows, size_t begin, size_t end) const {
+        auto& column = *std::get<I>(columns);
+        const auto member = std::get<I>(fields_).member;
+
+        for (size_t row = begin; row < end; ++row) {
+            column.Append(rows[row].*member);
+        }
+    }
+
+    template <size_t... I>
+    void AppendColumns(Block& block, const Columns& columns, std::index_sequence<I...>) const {
+        (block.AppendColumn(std::get<I>(fields_).name, std::get<I>(columns)), ...);
+    }
+
+private:
+    std::tuple<Fields...> fields_;
+};
+
+template <typename Struct, typename... Fields>
+RowMapping<Struct, Fields...> MakeRowMapping(Fields... fields) {
+    return RowMapping<Struct, Fields...>(std::move(fields)...);
+}
+
+/// Mapping used by Client::Insert(table, std::vector<Struct>), specialized by TIMEPLUS_ROW_MAPPING.
+template <typename Struct>
+struct RowMappingOf;
+
+}
+
+/** Declares mapping of `Struct` to the row of the stream, must be used in the global namespace:
+ *
+ *      TIMEPLUS_ROW_MAPPING(Trade,
+ *          BindField("id", &Trade::id),
+ *          BindField<ColumnLowCardinalityT<ColumnString>>("symbol", &Trade::symbol),
+ *          BindField("price", &Trade::price))
+ *
+ *      client.Insert("trades", trades);
+ */
+#define TIMEPLUS_ROW_MAPPING(Struct, ...)                                          \
+    namespace timeplus {                                                           \
+    template <>                                                                    \
+    struct RowMappingOf<Struct> {                                                  \
+        static const auto& Get() {                                                 \
+            static const auto mapping = MakeRowMapping<Struct>(__VA_ARGS__);       \
+            return mapping;                                                        \
+        }                                                                          \
+    };                                                                             \
+    }
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "block.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace timeplus {
+
+/** Block with a schema fixed at compile time, for producers appending data row by row.
+ *
+ *  Column types are template parameters, so AppendRow resolves every per-column Append
+ *  at compile time: there are no virtual calls, downcasts or per-row checks of the column types.
+ *
+ *      TypedBlock<ColumnUInt64, ColumnString, ColumnLowCardinalityT<ColumnString>> block({"id", "name", "tag"});
+ *      block.AppendRow(1, "foo", "bar");
+ *      client.Insert("stream", block.ToBlock());
+ *      block.Clear();
+ *
+ *  ToBlock() is zero-copy: resulting Block refers to the very same column objects,
+ *  so rows must not be appended while that Block is in use. Clear() leaves such Block intact.
+ */
+template <typename... Columns>
+class TypedBlock {
+    static_assert(sizeof...(Columns) > 0, "TypedBlock must have at least one column");
+
+public:
+    static constexpr size_t COLUMN_COUNT = sizeof...(Columns);
+
+    using Names = std::array<std::string, COLUMN_COUNT>;
+
+    /// Creates default-constructed columns.
+    explicit TypedBlock(Names names)
+        : TypedBlock(std::move(names), std::make_shared<Columns>()...)
+    {}
+
+    /// Uses given (empty) columns, i.e. for types with parameters like ColumnDateTime64 or ColumnDecimal.
+    TypedBlock(Names names, std::shared_ptr<Columns>... columns)
+        : names_(std::move(names))
+        , columns_(std::move(columns)...)
+        , rows_(0)
+    {}
+
+    /// Appends a row, values are passed to Append() of corresponding columns in order.
+    /// If any Append() throws, the row is removed from columns it was appended to, and the exception is rethrown.
+    template <typename... Values>
+    inline void AppendRow(Values&&... values) {
+        static_assert(sizeof...(Values) == COLUMN_COUNT, "AppendRow expects exactly one value per column");
+
+        try {
+            AppendValues(std::index_sequence_for<Columns...>{}, std::forward<Values>(values)...);
+        } catch (...) {
+            std::apply([this] (auto&... column) { (Truncate(*column), ...); }, columns_);
+            throw;
+        }
+        ++rows_;
+    }
+
+    /// Increase the capacity of all columns.
+    void Reserve(size_t rows) {
+        std::apply([rows] (auto&... column) { (column->Reserve(rows), ...); }, columns_);
+    }
+
+    /// Removes all rows. Columns still referred to by previously made blocks are replaced with new (empty) ones,
+    /// the others are cleared to be refilled.
+    void Clear() {
+        std::apply([] (auto&... column) { (ClearColumn(column), ...); }, columns_);
+        rows_ = 0;
+    }
+
+    inline size_t GetRowCount() const { return rows_; }
+
+    inline const std::string& GetColumnName(size_t idx) const { return names_.at(idx); }
+
+    /// Typed reference to the column by index.
+    template <size_t I>
+    inline const auto& GetColumn() const { return std::get<I>(columns_); }
+
+    /// Returns Block referring to the columns of this TypedBlock, without copying any data.
+    Block ToBlock() const {
+        Block block(COLUMN_COUNT, rows_);
+        AppendColumns(block, std::index_sequence_for<Columns...>{});
+        return block;
+    }
+
+private:
+    template <size_t... I, typename... Values>
+    inline void AppendValues(std::index_sequence<I...>, Values&&... values) {
+        (std::get<I>(columns_)->Append(std::forward<Values>(values)), ...);
+    }
+
+    template <size_t... I>
+    void AppendColumns(Block& block, std::index_sequence<I...>) const {
+        (block.AppendColumn(names_[I], std::get<I>(columns_)), ...);
+    }
+
+    /// Drops values of a partially appended row.
+    void Truncate(Column& column) const {
+        if (column.Size() > rows_) {
+            column.Swap(*column.Slice(0, rows_));
+        }
+    }
+
+    template <typename ColumnType>
+    static void ClearColumn(std::shared_ptr<ColumnType>& column) {
+        if (column.use_count() == 1) {
+            column->Clear();
+        } else {
+            column = column->CloneEmpty()->template AsStrict<ColumnType>();
+        }
+    }
+
+private:
+    Names names_;
+    std::tuple<std::shared_ptr<Columns>...> columns_;
+    size_t rows_;
+};
+
+}
@@ -307,11 +307,37 @@ std::string DecimalType::GetName() const {
 
 /// class EnumType
 
+namespace {
+/// Enum16 values may be anywhere in -32768 .. 32767, dense lookup table is built only if they are not too far apart.
+constexpr size_t MAX_DENSE_ENUM_VALUES = 4096;
+}
+
 EnumType::EnumType(Type::Code type, const std::vector<EnumItem>& items) : Type(type) {
     for (const auto& item : items) {
         auto result = name_to_value_.insert(item);
         value_to_name_[item.second] = result.first->first;
     }
+
+    name_index_.reserve(name_to_value_.size());
+    for (const auto& [name, value] : name_to_value_) {
+        name_index_.emplace(name, value);
+    }
+
+    if (!value_to_name_.empty()) {
+        const int32_t min_value = value_to_name_.begin()->first;
+        const int32_t max_value = value_to_name_.rbegin()->first;
+        if (static_cast<size_t>(max_value - min_value) < MAX_DENSE_ENUM_VALUES) {
+            min_dense_value_ = static_cast<int16_t>(min_value);
+            dense_names_.resize(static_cast<size_t>(max_value - min_value) + 1, nullptr);
+            for (const auto& [value, name] : value_to_name_) {
+                dense_names_[static_cast<size_t>(value - min_value)] = &name;
+            }
+        }
+    }
+}
+
+size_t EnumType::NameHash::operator()(std::string_view name) const noexcept {
+    return static_cast<size_t>(CityHash64(name.data(), name.size()));
 }
 
 std::string EnumType::GetName() const {
@@ -342,19 +368,45 @@ std::string EnumType::GetName() const {
 }
 
 std::string_view EnumType::GetEnumName(int16_t value) const {
-    return value_to_name_.at(value);
+    if (const auto name = FindEnumName(value)) {
+        return *name;
+    }
+    throw std::out_of_range("Enum type doesn't have value " + std::to_string(value));
 }
 
-int16_t EnumType::GetEnumValue(const std::string& name) const {
-    return name_to_value_.at(name);
+int16_t EnumType::GetEnumValue(std::string_view name) const {
+    int16_t value;
+    if (FindEnumValue(name, value)) {
+        return value;
+    }
+    throw std::out_of_range("Enum type doesn't have name '" + std::string(name) + "'");
 }
 
-bool EnumType::HasEnumName(const std::string& name) const {
-    return name_to_value_.find(name) != name_to_value_.end();
+bool EnumType::HasEnumName(std::string_view name) const {
+    return name_index_.find(name) != nullptr;
 }
 
 bool EnumType::HasEnumValue(int16_t value) const {
-    return value_to_name_.find(value) != value_to_name_.end();
+    return FindEnumName(value) != nullptr;
+}
+
+const std::string_view* EnumType::FindEnumName(int16_t value) const {
+    if (!dense_names_.empty()) {
+        const auto pos = static_cast<size_t>(int32_t(value) - int32_t(min_dense_value_));
+        // Values below min_dense_value_ wrap around to huge positions.
+        return pos < dense_names_.size() ? dense_names_[pos] : nullptr;
+    }
+
+    const auto it = value_to_name_.find(value);
+    return it != value_to_name_.end() ? &it->second : nullptr;
+}
+
+bool EnumType::FindEnumValue(std::string_view name, int16_t& value) const {
+    if (const auto item = name_index_.find(name)) {
+        value = item->second;
+        return true;
+    }
+    return false;
 }
 
 EnumType::ValueToNameIterator EnumType::BeginValueToName() const {
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "absl/numeric/int128.h"
+#include "timeplus/base/flat_hash_map.h"
 #include "timeplus/base/wide_integer.h"
 
 #include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 
@@ -236,20 +238,35 @@ public:
 
     std::string GetName() const;
 
-    /// Methods to work with enum types.
+    /// Methods to work with enum types, GetEnumName() and GetEnumValue() throw std::out_of_range for unknown items.
     std::string_view GetEnumName(int16_t value) const;
-    int16_t GetEnumValue(const std::string& name) const;
-    bool HasEnumName(const std::string& name) const;
+    int16_t GetEnumValue(std::string_view name) const;
+    bool HasEnumName(std::string_view name) const;
     bool HasEnumValue(int16_t value) const;
 
+    /// Same as above, without exceptions: return nullptr or false for unknown items.
+    const std::string_view* FindEnumName(int16_t value) const;
+    bool FindEnumValue(std::string_view name, int16_t& value) const;
+
 private:
     using ValueToNameType     = std::map<int16_t, std::string_view>;
     using NameToValueType     = std::map<std::string, int16_t>;
     using ValueToNameIterator = ValueToNameType::const_iterator;
 
+    struct NameHash {
+        size_t operator()(std::string_view name) const noexcept;
+    };
+
     ValueToNameType value_to_name_;
     NameToValueType name_to_value_;
 
+    /// Lookup indexes, built once, refer to items of the maps above.
+    FlatHashMap<std::string_view, int16_t, NameHash> name_index_;
+    /// Names of values from min_dense_value_ on, nullptr for gaps.
+    /// Covers all values of Enum8, empty for Enum16 with values too far apart.
+    std::vector<const std::string_view*> dense_names_;
+    int16_t min_dense_value_ = 0;
+
 public:
     ValueToNameIterator BeginValueToName() const;
     ValueToNameIterator EndValueToName() const;
@@ -360,6 +360,18 @@ TYPED_TEST(GenericColumnTest, Clear) {
     EXPECT_EQ(0u, column->Size());
 }
 
+TYPED_TEST(GenericColumnTest, ByteSize) {
+    const auto empty_column = this->MakeColumn();
+    EXPECT_LE(empty_column->ByteSize(), empty_column->AllocatedBytes());
+
+    auto [column, values] = this->MakeColumnWithValues(10'000);
+    EXPECT_GE(column->ByteSize(), empty_column->ByteSize() + values.size());
+    EXPECT_LE(column->ByteSize(), column->AllocatedBytes());
+
+    column->Clear();
+    EXPECT_EQ(empty_column->ByteSize(), column->ByteSize());
+}
+
 TYPED_TEST(GenericColumnTest, Swap) {
     auto [column_A, values] = this->MakeColumnWithValues(10'000);
     auto column_B = this->MakeColumn();
@@ -1,5 +1,6 @@
 #include <timeplus/columns/factory.h>
 #include <timeplus/columns/date.h>
+#include <timeplus/columns/nullable.h>
 #include <timeplus/columns/numeric.h>
 #include <timeplus/columns/string.h>
 
@@ -42,6 +43,17 @@ TEST(CreateColumnByType, LowCardinalityAsWrappedColumn) {
     ASSERT_EQ(Type::FixedString, CreateColumnByType("low_cardinality(fixed_string(10000))", create_column_settings)->As<ColumnFixedString>()->GetType().GetCode());
 }
 
+TEST(CreateColumnByType, StringCompactLayout) {
+    CreateColumnByTypeSettings create_column_settings;
+    create_column_settings.string_compact_layout = true;
+
+    ASSERT_EQ(ColumnString::Layout::Compact, CreateColumnByType("string", create_column_settings)->As<ColumnString>()->GetLayout());
+    ASSERT_EQ(ColumnString::Layout::Default, CreateColumnByType("string")->As<ColumnString>()->GetLayout());
+
+    auto nullable = CreateColumnByType("nullable(string)", create_column_settings)->As<ColumnNullable>();
+    ASSERT_EQ(ColumnString::Layout::Compact, nullable->Nested()->As<ColumnString>()->GetLayout());
+}
+
 TEST(CreateColumnByType, DateTime) {
     ASSERT_NE(nullptr, CreateColumnByType("datetime"));
     ASSERT_NE(nullptr, CreateColumnByType("datetime('Europe/Moscow')"));
@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 namespace {
 using namespace timeplus;
 
@@ -19,8 +21,23 @@ Block MakeBlock(std::vector<std::pair<std::string, ColumnRef>> columns) {
     return result;
 }
 
+struct Trade {
+    int64_t id;
+    std::string symbol;
+    double price;
+    uint32_t volume;
+    std::time_t time;
+};
+
 }
 
+TIMEPLUS_ROW_MAPPING(Trade,
+    BindField("id", &Trade::id),
+    BindField<ColumnLowCardinalityT<ColumnString>>("symbol", &Trade::symbol),
+    BindField("price", &Trade::price),
+    BindField("volume", &Trade::volume),
+    BindField<ColumnDateTime>("time", &Trade::time, [] { return std::make_shared<ColumnDateTime>("UTC"); }))
+
 TEST(BlockTest, Iterator) {
     const auto block = MakeBlock({
         {"foo", std::make_shared<ColumnUInt8>(std::vector<uint8_t>{1, 2, 3, 4, 5})},
@@ -83,3 +100,153 @@ TEST(BlockTest, Iterators) {
     ASSERT_NE(block.cbegin(), block.cend());
 }
 
+
+TEST(BlockTest, TypedBlock) {
+    TypedBlock<ColumnUInt64, ColumnString, ColumnLowCardinalityT<ColumnString>, ColumnDateTime64> typed_block(
+        {"id", "name", "tag", "time"},
+        std::make_shared<ColumnUInt64>(),
+        std::make_shared<ColumnString>(),
+        std::make_shared<ColumnLowCardinalityT<ColumnString>>(),
+        std::make_shared<ColumnDateTime64>(3));
+
+    typed_block.Reserve(3);
+    typed_block.AppendRow(1u, "foo", "a", Int64{1700000000000});
+    typed_block.AppendRow(2u, std::string("bar"), "b", Int64{1700000000001});
+    typed_block.AppendRow(3u, std::string_view("baz"), "a", Int64{1700000000002});
+    ASSERT_EQ(3u, typed_block.GetRowCount());
+    EXPECT_EQ("baz", typed_block.GetColumn<1>()->At(2));
+
+    const auto block = typed_block.ToBlock();
+    ASSERT_EQ(4u, block.GetColumnCount());
+    ASSERT_EQ(3u, block.GetRowCount());
+
+    const char* names[] = {"id", "name", "tag", "time"};
+    for (const auto & name_and_col : block) {
+        EXPECT_EQ(names[name_and_col.ColumnIndex()], name_and_col.Name());
+        EXPECT_EQ(3u, name_and_col.Column()->Size());
+    }
+
+    // Block refers to the same columns, no data is copied.
+    EXPECT_EQ(typed_block.GetColumn<0>().get(), block[0].get());
+    EXPECT_EQ(typed_block.GetColumn<3>().get(), block[3].get());
+
+    EXPECT_EQ(2u, block[0]->As<ColumnUInt64>()->At(1));
+    EXPECT_EQ("a", block[2]->As<ColumnLowCardinalityT<ColumnString>>()->At(2));
+    EXPECT_EQ(1700000000001, block[3]->As<ColumnDateTime64>()->At(1));
+    EXPECT_EQ(3u, block[3]->As<ColumnDateTime64>()->GetPrecision());
+
+    // Clearing leaves the block intact, columns it refers to are replaced.
+    typed_block.Clear();
+    EXPECT_EQ(0u, typed_block.GetRowCount());
+    EXPECT_EQ(0u, typed_block.ToBlock().GetRowCount());
+    EXPECT_NE(typed_block.GetColumn<0>().get(), block[0].get());
+    EXPECT_EQ(0u, typed_block.GetColumn<0>()->Size());
+    EXPECT_EQ(3u, typed_block.GetColumn<3>()->GetPrecision());
+    EXPECT_EQ(3u, block[0]->Size());
+    EXPECT_EQ("baz", block[1]->As<ColumnString>()->At(2));
+
+    // Columns no block refers to are cleared in place.
+    const auto column = typed_block.GetColumn<0>().get();
+    typed_block.AppendRow(4u, "qux", "c", Int64{1700000000003});
+    typed_block.Clear();
+    EXPECT_EQ(column, typed_block.GetColumn<0>().get());
+
+    // Columns are default-constructed when not given explicitly.
+    TypedBlock<ColumnInt32, ColumnFloat64> defaults({"x", "y"});
+    defaults.AppendRow(-1, 0.5);
+    EXPECT_EQ(1u, defaults.ToBlock().GetRowCount());
+    EXPECT_EQ("y", defaults.GetColumnName(1));
+}
+
+TEST(BlockTest, TypedBlock_AppendRowFailure) {
+    TypedBlock<ColumnUInt64, ColumnString, ColumnFixedString, ColumnInt8> typed_block(
+        {"id", "name", "code", "flag"},
+        std::make_shared<ColumnUInt64>(),
+        std::make_shared<ColumnString>(),
+        std::make_shared<ColumnFixedString>(3),
+        std::make_shared<ColumnInt8>());
+
+    typed_block.AppendRow(1u, "foo", "abc", int8_t{1});
+    // Value is too long for FixedString(3), so the row is rolled back from the columns it made it to.
+    EXPECT_THROW(typed_block.AppendRow(2u, "bar", "abcd", int8_t{0}), ValidationError);
+    typed_block.AppendRow(3u, "baz", "xyz", int8_t{0});
+
+    ASSERT_EQ(2u, typed_block.GetRowCount());
+    const auto block = typed_block.ToBlock();
+    ASSERT_EQ(2u, block.GetRowCount());
+    for (size_t i = 0; i < block.GetColumnCount(); ++i) {
+        EXPECT_EQ(2u, block[i]->Size()) << " column: " << block.GetColumnName(i);
+    }
+    EXPECT_EQ(3u, typed_block.GetColumn<0>()->At(1));
+    EXPECT_EQ("baz", typed_block.GetColumn<1>()->At(1));
+    EXPECT_EQ("xyz", typed_block.GetColumn<2>()->At(1));
+}
+
+TEST(BlockTest, RowMapping) {
+    std::vector<Trade> trades;
+    for (size_t i = 0; i < 1000; ++i) {
+        trades.push_back(Trade{
+            static_cast<int64_t>(i), "S" + std::to_string(i % 7), static_cast<double>(i) / 4,
+            static_cast<uint32_t>(i * 10), static_cast<std::time_t>(1700000000 + i)});
+    }
+
+    // Executor as an application may have, running tasks on its own threads.
+    size_t tasks_run = 0;
+    const ParallelExecutor executor = [&tasks_run] (size_t count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; ++i) {
+            threads.emplace_back(task, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        tasks_run += count;
+    };
+
+    const auto& mapping = RowMappingOf<Trade>::Get();
+    for (size_t workers : {0, 1, 2, 5, 8}) {
+        SCOPED_TRACE(workers);
+        const auto block = workers ? mapping.ToBlock(trades, executor, workers) : mapping.ToBlock(trades);
+
+        ASSERT_EQ(5u, block.GetColumnCount());
+        ASSERT_EQ(trades.size(), block.GetRowCount());
+        EXPECT_EQ("symbol", block.GetColumnName(1));
+        EXPECT_EQ(Type::CreateSimple<int64_t>()->GetName(), block[0]->GetType().GetName());
+        EXPECT_EQ(Type::CreateSimple<double>()->GetName(), block[2]->GetType().GetName());
+
+        const auto id = block[0]->As<ColumnInt64>();
+        const auto symbol = block[1]->As<ColumnLowCardinalityT<ColumnString>>();
+        const auto price = block[2]->As<ColumnFloat64>();
+        const auto volume = block[3]->As<ColumnUInt32>();
+        const auto time = block[4]->As<ColumnDateTime>();
+        ASSERT_TRUE(id && symbol && price && volume && time);
+
+        for (size_t i = 0; i < trades.size(); ++i) {
+            EXPECT_EQ(trades[i].id, id->At(i));
+            EXPECT_EQ(trades[i].symbol, symbol->At(i));
+            EXPECT_EQ(trades[i].price, price->At(i));
+            EXPECT_EQ(trades[i].volume, volume->At(i));
+            EXPECT_EQ(trades[i].time, time->At(i));
+        }
+    }
+
+    // Single worker runs on the calling thread, there are no more workers than columns.
+    EXPECT_EQ(2u + 5u + 5u, tasks_run);
+    EXPECT_EQ(0u, mapping.ToBlock(std::vector<Trade>{}).GetRowCount());
+}
+
+TEST(BlockTest, ByteSize) {
+    auto ids = std::make_shared<ColumnUInt64>(std::vector<uint64_t>{1, 2, 3});
+    auto names = std::make_shared<ColumnString>(ColumnString::Layout::Compact);
+    names->Append("one");
+    names->Append("two");
+    names->Append("three");
+
+    const auto block = MakeBlock({{"id", ids}, {"name", names}});
+    EXPECT_EQ(3 * sizeof(uint64_t) + (3 * sizeof(uint64_t) + 11), block.ByteSize());
+    EXPECT_EQ(ids->ByteSize() + names->ByteSize(), block.ByteSize());
+    EXPECT_EQ(ids->AllocatedBytes() + names->AllocatedBytes(), block.AllocatedBytes());
+    EXPECT_LE(block.ByteSize(), block.AllocatedBytes());
+
+    EXPECT_EQ(0u, Block().ByteSize());
+}
@@ -400,3 +400,88 @@ TEST(ColumnArrayT, const_right_value_no_move) {
         EXPECT_EQ(values[2], value2);
     }
 }
+
+TEST(ColumnArrayT, BeginRowEndRow) {
+    ColumnArrayT<ColumnUInt64> array;
+
+    for (uint64_t row = 0; row < 4; ++row) {
+        auto & items = array.BeginRow();
+        for (uint64_t i = 0; i < row; ++i) {
+            items.Append(row * 10 + i);
+        }
+        array.EndRow();
+    }
+
+    ASSERT_EQ(4u, array.Size());
+    EXPECT_EQ(0u, array.At(0).size());
+    EXPECT_EQ(1u, array.At(1).size());
+    EXPECT_EQ(20u, array.At(2)[0]);
+    EXPECT_EQ(21u, array.At(2)[1]);
+    EXPECT_EQ(32u, array.At(3)[2]);
+
+    // Builder of nested arrays.
+    ColumnArrayT<ColumnArrayT<ColumnString>> array_2d;
+    auto & rows = array_2d.BeginRow();
+    rows.BeginRow().Append("a");
+    rows.EndRow();
+    rows.EndRow();
+    array_2d.EndRow();
+
+    ASSERT_EQ(1u, array_2d.Size());
+    ASSERT_EQ(2u, array_2d.At(0).size());
+    EXPECT_EQ("a", array_2d.At(0)[0][0]);
+    EXPECT_EQ(0u, array_2d.At(0)[1].size());
+}
+
+TEST(ColumnArrayT, AppendRows) {
+    const std::vector<uint64_t> offsets{2, 2, 5};
+    const std::vector<uint32_t> values{1, 2, 3, 4, 5};
+
+    ColumnArrayT<ColumnUInt32> array;
+    array.Append(std::vector<uint32_t>{100});
+    array.AppendRows(offsets, values);
+    array.AppendRows(offsets, std::make_shared<ColumnUInt32>(values));
+
+    const auto row_values = [&array] (size_t row) {
+        std::vector<uint32_t> result;
+        for (const auto value : array.At(row)) {
+            result.push_back(value);
+        }
+        return result;
+    };
+
+    ASSERT_EQ(7u, array.Size());
+    EXPECT_EQ(std::vector<uint32_t>{100}, row_values(0));
+    for (size_t repeat : {0u, 3u}) {
+        EXPECT_EQ((std::vector<uint32_t>{1, 2}), row_values(1 + repeat));
+        EXPECT_EQ(0u, array.At(2 + repeat).size());
+        EXPECT_EQ((std::vector<uint32_t>{3, 4, 5}), row_values(3 + repeat));
+    }
+
+    // Malformed offsets or values of another type are rejected and don't modify the column.
+    EXPECT_THROW(array.AppendRows(std::vector<uint64_t>{3, 2, 5}, values), ValidationError);
+    EXPECT_THROW(array.AppendRows(std::vector<uint64_t>{2, 4}, values), ValidationError);
+    EXPECT_THROW(array.AppendRows(offsets, std::make_shared<ColumnUInt64>(std::vector<uint64_t>{1, 2, 3, 4, 5})), ValidationError);
+    EXPECT_EQ(7u, array.Size());
+
+    // Strings are appended one by one.
+    ColumnArrayT<ColumnString> strings;
+    const std::vector<std::string_view> items{"a", "b", "c"};
+    strings.AppendRows(std::vector<uint64_t>{1, 3}, items);
+    ASSERT_EQ(2u, strings.Size());
+    EXPECT_EQ("c", strings.At(1)[1]);
+}
+
+TEST(ColumnArray, AppendColumn) {
+    auto array = CreateArray<ColumnUInt64>(std::vector<std::vector<uint64_t>>{{1, 2}, {}, {3}});
+    auto other = CreateArray<ColumnUInt64>(std::vector<std::vector<uint64_t>>{{4}, {5, 6}});
+
+    array->Append(other);
+    array->Append(array);
+
+    ASSERT_EQ(10u, array->Size());
+    const std::vector<std::vector<uint64_t>> expected{{1, 2}, {}, {3}, {4}, {5, 6}};
+    for (size_t i = 0; i < array->Size(); ++i) {
+        EXPECT_TRUE(CompareRecursive(expected[i % expected.size()], *array->GetAsColumnTyped<ColumnUInt64>(i)));
+    }
+}
@@ -1,8 +1,10 @@
 #include <timeplus/columns/array.h>
+#include <timeplus/columns/columnview.h>
 #include <timeplus/columns/tuple.h>
 #include <timeplus/columns/date.h>
 #include <timeplus/columns/enum.h>
 #include <timeplus/columns/factory.h>
+#include <timeplus/columns/geo.h>
 #include <timeplus/columns/lowcardinality.h>
 #include <timeplus/columns/nullable.h>
 #include <timeplus/columns/numeric.h>
@@ -13,14 +15,18 @@
 #include <timeplus/columns/ip6.h>
 #include <timeplus/base/input.h>
 #include <timeplus/base/output.h>
+#include <timeplus/base/wire_format.h>
 #include <timeplus/base/socket.h> // for ipv4-ipv6 platform-specific stuff
 
 #include <gtest/gtest.h>
 #include "utils.h"
 #include "value_generators.h"
 
+#include <cmath>
+#include <cstring>
 #include <string_view>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include <random>
 
@@ -58,6 +64,239 @@ TEST(ColumnsCase, NumericSlice) {
     ASSERT_EQ(sub->At(2), 13u);
 }
 
+TEST(ColumnsCase, NumericAppendRange) {
+    const auto numbers = MakeNumbers();
+    auto col = std::make_shared<ColumnUInt32>();
+    col->Append(1);
+    col->AppendRange(numbers.data(), numbers.size());
+    col->AppendRange(numbers.data(), 0);
+
+    ASSERT_EQ(col->Size(), numbers.size() + 1);
+    ASSERT_EQ(col->At(0), 1u);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        EXPECT_EQ(col->At(i + 1), numbers[i]);
+    }
+}
+
+TEST(ColumnsCase, NumericAdopt) {
+    const auto numbers = MakeNumbers();
+    size_t released = 0;
+    const auto release = [&released] (const uint32_t*) { ++released; };
+
+    auto col = std::make_shared<ColumnUInt32>();
+    col->Append(100);
+    col->Adopt(numbers.data(), numbers.size(), release);
+
+    ASSERT_TRUE(col->IsAdopted());
+    ASSERT_EQ(col->Size(), numbers.size());
+    ASSERT_EQ(col->GetData().data(), numbers.data());
+    ASSERT_EQ(col->At(3), 7u);
+    ASSERT_THROW(col->At(numbers.size()), std::out_of_range);
+    ASSERT_EQ(col->Slice(3, 2)->As<ColumnUInt32>()->At(1), 11u);
+
+    // Body is written straight from the adopted memory, same as for a regular column.
+    Buffer adopted_body, copied_body;
+    {
+        BufferOutput output(&adopted_body);
+        col->SaveBody(&output);
+    }
+    {
+        BufferOutput output(&copied_body);
+        ColumnUInt32(numbers).SaveBody(&output);
+    }
+    EXPECT_EQ(copied_body, adopted_body);
+    EXPECT_EQ(released, 0u);
+
+    // Modification copies elements and releases adopted memory.
+    col->Append(1000);
+    EXPECT_FALSE(col->IsAdopted());
+    EXPECT_EQ(released, 1u);
+    ASSERT_EQ(col->Size(), numbers.size() + 1);
+    EXPECT_EQ(col->At(3), 7u);
+    EXPECT_EQ(col->At(numbers.size()), 1000u);
+
+    col->Adopt(numbers.data(), numbers.size(), release);
+    auto other = std::make_shared<ColumnUInt32>();
+    other->Append(col);
+    EXPECT_EQ(other->Size(), numbers.size());
+    other->Swap(*col);
+    EXPECT_TRUE(other->IsAdopted());
+    EXPECT_FALSE(col->IsAdopted());
+
+    other->Clear();
+    EXPECT_EQ(released, 2u);
+    EXPECT_EQ(other->Size(), 0u);
+
+    col->Adopt(numbers.data(), numbers.size(), release);
+    col.reset();
+    EXPECT_EQ(released, 3u);
+}
+
+TEST(ColumnsCase, NumericSlice_SharesMemory) {
+    auto col = std::make_shared<ColumnUInt32>(MakeNumbers());
+    const auto sub = col->Slice(3, 4)->As<ColumnUInt32>();
+
+    // Slice refers to the same memory.
+    ASSERT_EQ(sub->Size(), 4u);
+    EXPECT_EQ(sub->GetData().data(), col->GetData().data() + 3);
+
+    Buffer slice_body, copy_body;
+    {
+        BufferOutput output(&slice_body);
+        sub->SaveBody(&output);
+    }
+    {
+        BufferOutput output(&copy_body);
+        const auto numbers = MakeNumbers();
+        ColumnUInt32(std::vector<uint32_t>(numbers.begin() + 3, numbers.begin() + 7)).SaveBody(&output);
+    }
+    EXPECT_EQ(copy_body, slice_body);
+
+    // Modification of either column doesn't affect the other one.
+    col->GetWritableData()[3] = 1000;
+    col->Append(2000);
+    EXPECT_EQ(sub->At(0), 7u);
+    sub->Append(3000);
+    EXPECT_EQ(col->Size(), 12u);
+    EXPECT_EQ(sub->Size(), 5u);
+    EXPECT_EQ(sub->At(4), 3000u);
+
+    // Slice outlives the column.
+    const auto sub_of_sub = sub->Slice(1, 10);
+    col.reset();
+    EXPECT_EQ(sub_of_sub->Size(), 4u);
+    EXPECT_EQ(sub_of_sub->As<ColumnUInt32>()->At(0), 11u);
+}
+
+TEST(ColumnsCase, NumericSelfAppend) {
+    const auto check = [](const ColumnUInt64& col, size_t rows) {
+        ASSERT_EQ(col.Size(), rows * 2);
+        for (size_t i = 0; i < rows * 2; ++i) {
+            ASSERT_EQ(col.At(i), i % rows);
+        }
+    };
+
+    // After the slice is gone, column is the only owner of the shared memory.
+    auto col = std::make_shared<ColumnUInt64>();
+    for (uint64_t i = 0; i < 1000; ++i) {
+        col->Append(i);
+    }
+    {
+        auto sub = col->Slice(0, 10);
+    }
+    col->Append(col);
+    check(*col, 1000);
+
+    // Adopted memory.
+    std::vector<uint64_t> numbers(1000);
+    for (uint64_t i = 0; i < numbers.size(); ++i) {
+        numbers[i] = i;
+    }
+    col->Adopt(numbers.data(), numbers.size(), [](const uint64_t*) {});
+    col->Append(col);
+    check(*col, 1000);
+
+    // Own elements, without reserved capacity to append them in place.
+    col = std::make_shared<ColumnUInt64>(std::vector<uint64_t>{0, 1, 2});
+    col->GetWritableData().shrink_to_fit();
+    col->Append(col);
+    check(*col, 3);
+}
+
+TEST(ColumnsCase, StringSlice_SharesMemory) {
+    const auto values = MakeStrings();
+    auto col = std::make_shared<ColumnString>(std::make_shared<StringBlockPool>());
+    for (const auto & value : values) {
+        col->Append(value);
+    }
+    col->Append(std::string(100, 'x'));
+
+    const auto sub = col->Slice(1, 3)->As<ColumnString>();
+    ASSERT_EQ(sub->Size(), 3u);
+    EXPECT_EQ(sub->At(0).data(), col->At(1).data());
+
+    // Column keeps appending, clears and refills, slice still refers to the original values.
+    col->Append("after slice");
+    const auto second = col->Slice(col->Size() - 2, 2)->As<ColumnString>();
+    col->Clear();
+    for (size_t i = 0; i < 100; ++i) {
+        col->Append(std::string(100, 'y'));
+    }
+
+    for (size_t i = 0; i < sub->Size(); ++i) {
+        EXPECT_EQ(sub->At(i), values[i + 1]);
+    }
+    EXPECT_EQ(second->At(0), std::string(100, 'x'));
+    EXPECT_EQ(second->At(1), "after slice");
+
+    sub->Append("appended to slice");
+    EXPECT_EQ(sub->At(3), "appended to slice");
+    EXPECT_EQ(sub->At(0), values[1]);
+
+    // Slices of slices and of columns that own strings.
+    auto owning = std::make_shared<ColumnString>(std::vector<std::string>{"a", "b", "c"});
+    auto sub_of_sub = owning->Slice(1, 2)->Slice(1, 1);
+    owning.reset();
+    ASSERT_EQ(sub_of_sub->Size(), 1u);
+    EXPECT_EQ(sub_of_sub->As<ColumnString>()->At(0), "c");
+}
+
+TEST(ColumnsCase, FixedStringSlice_SharesMemory) {
+    const auto values = MakeFixedStrings(3);
+    auto col = std::make_shared<ColumnFixedString>(3, values);
+    const auto sub = col->Slice(2, 3)->As<ColumnFixedString>();
+
+    ASSERT_EQ(sub->Size(), 3u);
+    EXPECT_EQ(sub->At(0).data(), col->At(2).data());
+    EXPECT_THROW(sub->At(3), std::out_of_range);
+
+    col->Append("new");
+    sub->Append("sub");
+    col.reset();
+
+    ASSERT_EQ(sub->Size(), 4u);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(sub->At(i), values[i + 2]);
+    }
+    EXPECT_EQ(sub->At(3), "sub");
+}
+
+TEST(ColumnsCase, Slice_KeepsSourceStorage) {
+    auto numbers = std::make_shared<ColumnUInt32>(MakeNumbers());
+    auto fixed = std::make_shared<ColumnFixedString>(3, MakeFixedStrings(3));
+    auto strings = std::make_shared<ColumnString>(MakeStrings());
+    const auto numbers_data = numbers->GetData().data();
+    const auto fixed_data = fixed->At(0).data();
+    const auto strings_data = strings->At(0).data();
+
+    // Const Slice() only copies references, so any number of readers may slice the same column at once.
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < 100; ++i) {
+                EXPECT_EQ(numbers->Slice(1, 2)->As<ColumnUInt32>()->At(0), numbers->At(1));
+                EXPECT_EQ(fixed->Slice(1, 2)->As<ColumnFixedString>()->At(0), fixed->At(1));
+                EXPECT_EQ(strings->Slice(1, 2)->As<ColumnString>()->At(0), strings->At(1));
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(numbers->GetData().data(), numbers_data);
+    EXPECT_EQ(fixed->At(0).data(), fixed_data);
+    EXPECT_EQ(strings->At(0).data(), strings_data);
+    EXPECT_FALSE(numbers->IsAdopted());
+
+    // Writable data obtained after slicing is the column's own copy.
+    const auto sub = numbers->Slice(0, 3);
+    auto & data = numbers->GetWritableData();
+    data[0] = 1000;
+    EXPECT_EQ(sub->As<ColumnUInt32>()->At(0), 1u);
+    EXPECT_EQ(numbers->At(0), 1000u);
+}
+
 
 TEST(ColumnsCase, FixedStringInit) {
     const auto column_data = MakeFixedStrings(3);
@@ -137,6 +376,297 @@ TEST(ColumnsCase, StringAppend) {
     ASSERT_EQ(col->At(2), "11");
 }
 
+TEST(ColumnsCase, String_Clear_RetainsBlocks) {
+    auto col = std::make_shared<ColumnString>();
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto value = "some string value " + std::to_string(i);
+        col->Append(std::string_view(value));
+    }
+
+    const auto allocated = col->AllocatedBytes();
+    col->Clear();
+    ASSERT_EQ(col->Size(), 0u);
+    // No pool is made up for the column, it retains no more than the cleared rows took.
+    EXPECT_EQ(col->GetBlockPool(), nullptr);
+    EXPECT_GT(col->AllocatedBytes(), 0u);
+    EXPECT_LE(col->AllocatedBytes(), allocated);
+
+    // Refilling with the same amount of data reuses retained blocks.
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto value = "some string value " + std::to_string(i);
+        col->Append(std::string_view(value));
+    }
+    EXPECT_EQ(col->AllocatedBytes(), allocated);
+    ASSERT_EQ(col->Size(), 1000u);
+    EXPECT_EQ(col->At(999), "some string value 999");
+
+    // Fewer rows retain fewer blocks.
+    col->Clear();
+    col->Append("x");
+    col->Clear();
+    EXPECT_LT(col->AllocatedBytes(), allocated);
+}
+
+TEST(ColumnsCase, String_Clear_SizesBlocksForClearedData) {
+    // Pool that retains nothing, so that every block is allocated anew.
+    ColumnString col(std::make_shared<StringBlockPool>(0));
+    col.Reserve(1000);
+    const std::string value(100, 'x');
+    const auto fill = [&] {
+        for (size_t i = 0; i < 1000; ++i) {
+            col.Append(std::string_view(value));
+        }
+    };
+
+    // Blocks grow from the default size while the column is filled the first time, the last one is partially filled...
+    fill();
+    EXPECT_GT(col.AllocatedBytes(), col.ByteSize());
+
+    // ...and are as large as the data of cleared rows afterwards: a single block holds all of it.
+    col.Clear();
+    fill();
+    EXPECT_EQ(col.AllocatedBytes(), col.ByteSize());
+}
+
+TEST(ColumnsCase, String_Clear_AcquiresPooledBlocksOfClearedDataSize) {
+    auto pool = std::make_shared<StringBlockPool>();
+    ColumnString col(pool);
+    const std::string value(100, 'x');
+    const auto fill = [&] {
+        for (size_t i = 0; i < 1000; ++i) {
+            col.Append(std::string_view(value));
+        }
+    };
+    fill();
+
+    {
+        // Leaves a single large block in the pool.
+        ColumnString large(pool);
+        large.Append(std::string_view(std::string(200000, 'a')));
+    }
+    const size_t large_block = pool->RetainedBytes();
+    ASSERT_GE(large_block, 200000u);
+
+    // Small blocks of the cleared rows are released after the large one, yet refilling takes the large one
+    // as it fits all the data, rather than splitting it across small blocks.
+    col.Clear();
+    const size_t retained = pool->RetainedBytes();
+    fill();
+    EXPECT_EQ(pool->RetainedBytes(), retained - large_block);
+    ASSERT_EQ(col.Size(), 1000u);
+    EXPECT_EQ(col.At(999), value);
+}
+
+TEST(ColumnsCase, String_SharedBlockPool) {
+    auto pool = std::make_shared<StringBlockPool>();
+    {
+        ColumnString col(pool);
+        const std::string value(10000, 'a');
+        col.Append(std::string_view(value));
+    }
+    // Storage of destroyed column goes back to the pool ...
+    EXPECT_GE(pool->RetainedBytes(), 10000u);
+
+    // ... and is picked up by another column sharing it.
+    ColumnString col(pool);
+    const std::string value(10000, 'b');
+    col.Append(std::string_view(value));
+    EXPECT_EQ(pool->RetainedBytes(), 0u);
+    EXPECT_EQ(col.At(0), std::string(10000, 'b'));
+
+    pool->Purge();
+    EXPECT_EQ(pool->RetainedBytes(), 0u);
+}
+
+TEST(ColumnsCase, String_CompactLayout) {
+    const auto values = MakeStrings();
+    auto col = std::make_shared<ColumnString>(ColumnString::Layout::Compact);
+    for (const auto & v : values) {
+        col->Append(v);
+    }
+
+    ASSERT_EQ(col->Size(), values.size());
+    ASSERT_EQ(col->GetOffsets().size(), values.size());
+    EXPECT_EQ(col->GetOffsets().back(), col->GetChars().size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col->At(i), values[i]) << " at pos: " << i;
+    }
+
+    auto slice = col->Slice(1, 3)->As<ColumnString>();
+    ASSERT_EQ(slice->GetLayout(), ColumnString::Layout::Compact);
+    ASSERT_EQ(slice->Size(), 3u);
+    for (size_t i = 0; i < slice->Size(); ++i) {
+        EXPECT_EQ(slice->At(i), values[i + 1]) << " at pos: " << i;
+    }
+
+    // Slice refers to the same memory, its offsets are relative to GetCharsBase().
+    EXPECT_EQ(slice->GetOffsets().data(), col->GetOffsets().data() + 1);
+    EXPECT_EQ(slice->GetChars().data(), col->At(1).data());
+    EXPECT_EQ(slice->GetCharsBase(), col->GetOffsets()[0]);
+    EXPECT_EQ(slice->GetChars().size(), col->GetOffsets()[3] - col->GetOffsets()[0]);
+    EXPECT_THROW(slice->At(3), std::out_of_range);
+
+    auto slice_of_slice = slice->Slice(1, 10)->As<ColumnString>();
+    ASSERT_EQ(slice_of_slice->Size(), 2u);
+    EXPECT_EQ(slice_of_slice->At(0), values[2]);
+    EXPECT_EQ(slice_of_slice->At(1).data(), col->At(3).data());
+
+    Buffer slice_body, copy_body;
+    {
+        BufferOutput output(&slice_body);
+        slice->SaveBody(&output);
+    }
+    {
+        BufferOutput output(&copy_body);
+        ColumnString(std::vector<std::string>(values.begin() + 1, values.begin() + 4)).SaveBody(&output);
+    }
+    EXPECT_EQ(copy_body, slice_body);
+
+    // Modification of either column doesn't affect the other one.
+    slice->Append("appended to slice");
+    ASSERT_EQ(slice->Size(), 4u);
+    EXPECT_EQ(slice->GetCharsBase(), 0u);
+    EXPECT_EQ(slice->At(0), values[1]);
+    EXPECT_EQ(slice->At(3), "appended to slice");
+    EXPECT_EQ(slice_of_slice->At(0), values[2]);
+    EXPECT_EQ(col->Size(), values.size());
+
+    // Self-append.
+    auto self = slice_of_slice->Slice(0, 2);
+    self->Append(self);
+    ASSERT_EQ(self->Size(), 4u);
+    EXPECT_EQ(self->As<ColumnString>()->At(3), values[3]);
+    slice->Append(slice);
+    ASSERT_EQ(slice->Size(), 8u);
+    EXPECT_EQ(slice->At(7), "appended to slice");
+
+    // Appending between layouts works both ways.
+    auto regular = std::make_shared<ColumnString>();
+    regular->Append(col);
+    col->Append(regular);
+    ASSERT_EQ(col->Size(), values.size() * 2);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(regular->At(i), values[i]) << " at pos: " << i;
+        EXPECT_EQ(col->At(values.size() + i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, String_CompactLayout_SaveAndLoad) {
+    const auto values = MakeStrings();
+    ColumnString col(ColumnString::Layout::Compact);
+    for (const auto & v : values) {
+        col.Append(v);
+    }
+
+    Buffer buffer;
+    {
+        BufferOutput output(&buffer);
+        col.Save(&output);
+    }
+
+    // Wire format is identical to the default layout.
+    ColumnString regular;
+    {
+        ArrayInput input(buffer.data(), buffer.size());
+        ASSERT_TRUE(regular.Load(&input, values.size()));
+    }
+
+    col.Clear();
+    ASSERT_EQ(col.Size(), 0u);
+    {
+        ArrayInput input(buffer.data(), buffer.size());
+        ASSERT_TRUE(col.Load(&input, values.size()));
+    }
+
+    ASSERT_EQ(col.Size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(i), values[i]) << " at pos: " << i;
+        EXPECT_EQ(regular.At(i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, String_LoadBody_AcrossBufferBoundaries) {
+    // Values of varying size, some larger than read buffer, so that lengths and values end up split between buffer refills.
+    std::vector<std::string> values;
+    for (size_t i = 0; i < 200; ++i) {
+        values.emplace_back(i * 7 % 300, static_cast<char>('a' + i % 26));
+    }
+
+    Buffer buffer;
+    {
+        ColumnString col(values);
+        BufferOutput output(&buffer);
+        col.SaveBody(&output);
+    }
+
+    for (const auto layout : {ColumnString::Layout::Default, ColumnString::Layout::Compact}) {
+        BufferedInput input(std::make_unique<ArrayInput>(buffer.data(), buffer.size()), 100);
+        ColumnString col(layout);
+        ASSERT_TRUE(col.LoadBody(&input, values.size()));
+
+        ASSERT_EQ(col.Size(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(col.At(i), values[i]) << " at pos: " << i;
+        }
+    }
+
+    // Not enough data.
+    ArrayInput input(buffer.data(), buffer.size() - 1);
+    ColumnString col;
+    EXPECT_FALSE(col.LoadBody(&input, values.size()));
+}
+
+TEST(ColumnsCase, ColumnView_Numeric) {
+    auto col = std::make_shared<ColumnInt64>(std::vector<int64_t>{1, -2, 3, 0});
+
+    ColumnView<int64_t> view(col);
+    ASSERT_EQ(view.size(), col->Size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(view[i], col->At(i));
+    }
+
+    int64_t sum = 0;
+    for (const auto value : ColumnView<int64_t>(*col)) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 2);
+
+    EXPECT_THROW(ColumnView<int32_t>{col}, ValidationError);
+    EXPECT_THROW(ColumnView<int64_t>{std::make_shared<ColumnString>()}, ValidationError);
+}
+
+TEST(ColumnsCase, ColumnView_DateAndDecimal) {
+    auto date = std::make_shared<ColumnDate>();
+    date->AppendRaw(1);
+    date->AppendRaw(19000);
+    EXPECT_EQ(ColumnView<uint16_t>(date)[1], 19000u);
+
+    auto date32 = std::make_shared<ColumnDate32>();
+    date32->AppendRaw(-5);
+    EXPECT_EQ(ColumnView<int32_t>(date32)[0], -5);
+
+    auto date_time = std::make_shared<ColumnDateTime>();
+    date_time->AppendRaw(1700000000u);
+    EXPECT_EQ(ColumnView<uint32_t>(date_time)[0], 1700000000u);
+
+    auto date_time64 = std::make_shared<ColumnDateTime64>(3);
+    date_time64->Append(1700000000123);
+    EXPECT_EQ(ColumnView<Int64>(date_time64)[0], 1700000000123);
+
+    auto decimal32 = std::make_shared<ColumnDecimal>(9, 2);
+    decimal32->Append(12345);
+    EXPECT_EQ(ColumnView<int32_t>(decimal32)[0], 12345);
+    EXPECT_THROW(ColumnView<int64_t>{decimal32}, ValidationError);
+
+    auto decimal64 = std::make_shared<ColumnDecimal>(18, 2);
+    decimal64->Append(-123456789012);
+    EXPECT_EQ(ColumnView<int64_t>(decimal64)[0], -123456789012);
+
+    auto decimal128 = std::make_shared<ColumnDecimal>(38, 2);
+    decimal128->Append(Int128(1) << 100);
+    EXPECT_EQ(ColumnView<Int128>(decimal128)[0], Int128(1) << 100);
+}
+
 TEST(ColumnsCase, TupleAppend){
     auto tuple1 = std::make_shared<ColumnTuple>(std::vector<ColumnRef>({
                                 std::make_shared<ColumnUInt64>(),
@@ -389,6 +919,92 @@ TEST(ColumnsCase, DateTime64_Swap_EXCEPTION) {
     EXPECT_ANY_THROW(column1->Swap(*column2));
 }
 
+TEST(ColumnsCase, DateTime_CivilTimes) {
+    std::shared_ptr<const TimeZone> berlin;
+    try {
+        berlin = TimeZone::Get("Europe/Berlin");
+    } catch (const ValidationError&) {
+        GTEST_SKIP() << "tz database is not available";
+    }
+
+    auto column = std::make_shared<ColumnDateTime>("Europe/Berlin");
+    const std::vector<uint32_t> raw = {0, 1711846799, 1711846800, 1729990799, 1729990800, 4294967295};
+    for (auto value : raw) {
+        column->AppendRaw(value);
+    }
+
+    std::vector<CivilTime> civil(raw.size());
+    column->ToCivilTimes(civil);
+    for (size_t i = 0; i < raw.size(); ++i) {
+        EXPECT_EQ(berlin->ToCivil(raw[i]), civil[i]);
+    }
+    EXPECT_EQ(3, civil[2].hour);
+
+    std::vector<CivilTime> utc(raw.size());
+    column->ToCivilTimes(utc, *TimeZone::Get(""));
+    EXPECT_EQ(1, utc[0].day);
+    EXPECT_EQ(0, utc[0].hour);
+
+    auto copy = std::make_shared<ColumnDateTime>("Europe/Berlin");
+    copy->AppendCivilTimes(civil);
+    ASSERT_EQ(raw.size(), copy->Size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        // The last but one value is the second occurrence of 02:00, it maps back to the first one.
+        EXPECT_EQ(i == 4 ? raw[i] - 3600 : raw[i], copy->GetRawData()[i]);
+    }
+
+    std::vector<CivilTime> too_small(1);
+    EXPECT_THROW(column->ToCivilTimes(too_small), ValidationError);
+
+    // Whole batch is rejected.
+    auto before_epoch = civil;
+    before_epoch.back().year = 1969;
+    EXPECT_THROW(copy->AppendCivilTimes(before_epoch, *TimeZone::Get("")), ValidationError);
+    EXPECT_EQ(raw.size(), copy->Size());
+}
+
+TEST(ColumnsCase, DateTime64_CivilTimes) {
+    auto column = std::make_shared<ColumnDateTime64>(3);
+
+    std::vector<CivilTime> civil(3);
+    civil[0].year = 1969;
+    civil[0].month = 12;
+    civil[0].day = 31;
+    civil[0].hour = 23;
+    civil[0].minute = 59;
+    civil[0].second = 59;
+    civil[0].nanosecond = 500000000;
+    civil[1].nanosecond = 123456789;
+    civil[2].year = 2262;
+    civil[2].month = 4;
+    civil[2].day = 12;
+
+    column->AppendCivilTimes(civil);
+    ASSERT_EQ(3u, column->Size());
+    EXPECT_EQ(-500, column->At(0));
+    EXPECT_EQ(123, column->At(1));
+    EXPECT_EQ(9223372800000, column->At(2));
+
+    std::vector<CivilTime> back(3);
+    column->ToCivilTimes(back);
+    EXPECT_EQ(civil[0], back[0]);
+    // Truncated to the precision of the column.
+    EXPECT_EQ(123000000u, back[1].nanosecond);
+    EXPECT_EQ(civil[2], back[2]);
+
+    auto invalid = civil;
+    invalid[1].nanosecond = 1000000000;
+    EXPECT_THROW(column->AppendCivilTimes(invalid), ValidationError);
+    EXPECT_EQ(3u, column->Size());
+
+    // Out of nanosecond DateTime64 range.
+    auto nanoseconds = std::make_shared<ColumnDateTime64>(9);
+    nanoseconds->AppendCivilTimes(Span<const CivilTime>(civil.data(), 2));
+    EXPECT_EQ(123456789, nanoseconds->At(1));
+    EXPECT_THROW(nanoseconds->AppendCivilTimes(civil), ValidationError);
+    EXPECT_EQ(2u, nanoseconds->Size());
+}
+
 TEST(ColumnsCase, Date2038) {
     auto col1 = std::make_shared<ColumnDate>();
     const std::time_t largeDate(25882ull * 86400ull);
@@ -420,6 +1036,39 @@ TEST(ColumnsCase, EnumTest) {
     ASSERT_TRUE(CreateColumnByType("enum8('Hi' = 1, 'Hello' = 2)")->Type()->IsEqual(Type::CreateEnum8(enum_items)));
 }
 
+TEST(ColumnsCase, EnumNames) {
+    const std::vector<Type::EnumItem> enum_items = {{"Hi", 1}, {"Hello", 2}, {"Bye", -3}};
+    ColumnEnum8 col(Type::CreateEnum8(enum_items));
+
+    const std::vector<std::string_view> names = {"Hello", "Bye", "Hi", "Hello"};
+    col.AppendNames(names);
+    ASSERT_EQ(names.size(), col.Size());
+    EXPECT_EQ(2, col.At(0));
+    EXPECT_EQ(-3, col.At(1));
+
+    ColumnString strings;
+    col.ToNames(strings);
+    ASSERT_EQ(names.size(), strings.Size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(names[i], strings.At(i));
+    }
+
+    ColumnEnum16 col16(Type::CreateEnum16(enum_items));
+    col16.AppendNames(strings);
+    EXPECT_EQ(std::vector<int16_t>({2, -3, 1, 2}), std::vector<int16_t>({col16[0], col16[1], col16[2], col16[3]}));
+
+    // Whole batch is rejected.
+    const std::vector<std::string_view> invalid = {"Hi", "Hola"};
+    EXPECT_THROW(col.AppendNames(invalid), ValidationError);
+    EXPECT_EQ(names.size(), col.Size());
+
+    EXPECT_NO_THROW(col.Append(-3, true));
+    EXPECT_THROW(col.Append(3, true), ValidationError);
+    EXPECT_NO_THROW(col.Append(3));
+    EXPECT_THROW(col.SetAt(0, 4, true), ValidationError);
+    EXPECT_EQ(2, col.At(0));
+}
+
 TEST(ColumnsCase, NullableSlice) {
     auto data = std::make_shared<ColumnUInt32>(MakeNumbers());
     auto nulls = std::make_shared<ColumnUInt8>(MakeBools());
@@ -435,6 +1084,70 @@ TEST(ColumnsCase, NullableSlice) {
     ASSERT_EQ(subData->At(3), 17u);
 }
 
+TEST(ColumnsCase, Nullable_NullMapBulkOperations) {
+    // Sizes around SSE2 (16 bytes) and AVX2 (32 bytes) blocks and the packing granularity.
+    for (size_t rows : {0u, 1u, 7u, 8u, 15u, 16u, 33u, 127u, 128u, 1000u}) {
+        SCOPED_TRACE(rows);
+
+        std::vector<uint8_t> null_map(rows);
+        size_t expected_nulls = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            null_map[i] = (i % 20 == 3 || i % 7 == 6) ? 1 : 0;
+            expected_nulls += null_map[i];
+        }
+        std::vector<uint32_t> values(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            values[i] = static_cast<uint32_t>(i);
+        }
+
+        auto col = std::make_shared<ColumnNullableT<ColumnUInt32>>();
+        col->AppendNested(std::make_shared<ColumnUInt32>(values), null_map);
+        ASSERT_EQ(rows, col->Size());
+        EXPECT_EQ(expected_nulls, col->CountNulls());
+        EXPECT_EQ(expected_nulls != 0, col->HasAnyNull());
+        for (size_t i = 0; i < rows; ++i) {
+            EXPECT_EQ(null_map[i] != 0, col->IsNull(i));
+            if (!null_map[i]) {
+                EXPECT_EQ(i, *col->At(i));
+            }
+        }
+
+        const auto packed = col->GetPackedNullMap();
+        ASSERT_EQ((rows + 7) / 8, packed.size());
+        for (size_t i = 0; i < rows; ++i) {
+            EXPECT_EQ(null_map[i], (packed[i / 8] >> (i % 8)) & 1);
+        }
+
+        // Round trip through packed representation, appended after existing rows.
+        auto copy = std::make_shared<ColumnNullableT<ColumnUInt32>>();
+        copy->Append(std::optional<uint32_t>{});
+        copy->AppendNestedPacked(std::make_shared<ColumnUInt32>(values), packed.data());
+        ASSERT_EQ(rows + 1, copy->Size());
+        EXPECT_EQ(expected_nulls + 1, copy->CountNulls());
+        for (size_t i = 0; i < rows; ++i) {
+            EXPECT_EQ(null_map[i], copy->GetNullMap()[i + 1]);
+        }
+    }
+}
+
+TEST(ColumnsCase, Nullable_HasAnyNull) {
+    std::vector<uint8_t> null_map(1000, 0);
+    auto col = std::make_shared<ColumnNullableT<ColumnUInt8>>();
+    col->AppendNested(std::make_shared<ColumnUInt8>(std::vector<uint8_t>(null_map.size(), 1)), null_map);
+    EXPECT_FALSE(col->HasAnyNull());
+    EXPECT_EQ(0u, col->CountNulls());
+
+    // Null flags are any non-zero bytes, as they can come from the wire as is.
+    col->AppendNested(std::make_shared<ColumnUInt8>(std::vector<uint8_t>{1}), std::vector<uint8_t>{0xFF});
+    EXPECT_TRUE(col->HasAnyNull());
+    EXPECT_EQ(1u, col->CountNulls());
+    EXPECT_EQ(1, col->GetPackedNullMap().back() >> (1000 % 8));
+
+    EXPECT_THROW(col->AppendNested(std::make_shared<ColumnUInt8>(), std::vector<uint8_t>{0}), ValidationError);
+    EXPECT_THROW(col->AppendNested(std::make_shared<ColumnUInt16>(std::vector<uint16_t>{1}), std::vector<uint8_t>{0}), ValidationError);
+    EXPECT_EQ(1001u, col->Size());
+}
+
 // internal representation of UUID data in ColumnUUID
 std::vector<uint64_t> MakeUUID_data() {
     return {
@@ -461,6 +1174,43 @@ TEST(ColumnsCase, UUIDSlice) {
     ASSERT_EQ(sub->At(1), UUID({0x3507213c178649f9llu, 0x9faf035d662f60aellu}));
 }
 
+TEST(ColumnsCase, UUIDStrings) {
+    const std::vector<std::string_view> texts = {
+        "bb6a8c69-9ab2-414c-8669-7b7fd27f0825",
+        "84B9F24B-C26B-49C6-A03B-4AB723341951",
+        "00000000-0000-0000-0000-000000000000",
+        "ffffffff-ffff-ffff-ffff-ffffffffffff",
+    };
+
+    ColumnUUID col;
+    col.AppendStrings(texts);
+    ASSERT_EQ(texts.size(), col.Size());
+    EXPECT_EQ(UUID({0xbb6a8c699ab2414cllu, 0x86697b7fd27f0825llu}), col.At(0));
+    EXPECT_EQ(UUID({0x84b9f24bc26b49c6llu, 0xa03b4ab723341951llu}), col.At(1));
+    EXPECT_EQ("84b9f24b-c26b-49c6-a03b-4ab723341951", col.AsString(1));
+
+    ColumnString strings;
+    col.ToStrings(strings);
+    ASSERT_EQ(texts.size(), strings.Size());
+    EXPECT_EQ(texts[0], strings.At(0));
+    EXPECT_EQ("84b9f24b-c26b-49c6-a03b-4ab723341951", strings.At(1));
+    EXPECT_EQ(texts[2], strings.At(2));
+    EXPECT_EQ(texts[3], strings.At(3));
+
+    for (const auto invalid : {
+            "bb6a8c69-9ab2-414c-8669-7b7fd27f082",
+            "bb6a8c69-9ab2-414c-8669-7b7fd27f08250",
+            "bb6a8c699ab2-414c-8669-7b7fd27f0825-",
+            "bb6a8c69-9ab2-414c-8669-7b7fd27f082g",
+            "bb6a8c69-9ab2-414c-8669-7b7fd27f082\xe6",
+            "bb6a8c69+9ab2-414c-8669-7b7fd27f0825",
+            "{b6a8c69-9ab2-414c-8669-7b7fd27f0825"}) {
+        const std::vector<std::string_view> values = {texts[0], invalid};
+        EXPECT_THROW(col.AppendStrings(values), ValidationError) << invalid;
+        EXPECT_EQ(texts.size(), col.Size());
+    }
+}
+
 TEST(ColumnsCase, Int128) {
 
     auto col = std::make_shared<ColumnInt128>(std::vector<Int128>{
@@ -667,6 +1417,99 @@ TEST(ColumnsCase, ColumnIPv6_construct_from_data)
     EXPECT_ANY_THROW(ColumnIPv6(ColumnRef(std::make_shared<ColumnString>())));
 }
 
+TEST(ColumnsCase, ColumnIPv6_Strings)
+{
+    const std::vector<std::string_view> texts = {"::1", "2001:DB8::8a2e:370:7334", "::ffff:204.152.189.116", "1:2:3:4:5:6:7:8"};
+    ColumnIPv6 col;
+    col.AppendStrings(texts);
+    ASSERT_EQ(texts.size(), col.Size());
+    EXPECT_EQ(MakeIPv6(0xff, 0xff, 204, 152, 189, 116), col.At(2));
+
+    ColumnString strings;
+    col.ToStrings(strings);
+    ASSERT_EQ(texts.size(), strings.Size());
+    EXPECT_EQ("::1", strings.At(0));
+    EXPECT_EQ("2001:db8::8a2e:370:7334", strings.At(1));
+    EXPECT_EQ("::ffff:204.152.189.116", strings.At(2));
+    EXPECT_EQ("1:2:3:4:5:6:7:8", strings.At(3));
+
+    // Not null-terminated.
+    const std::string text = "::1::";
+    col.Append(std::string_view(text.data(), 3));
+    EXPECT_EQ(MakeIPv6(0, 0, 0, 0, 0, 1), col.At(4));
+
+    // Whole batch is rejected.
+    const std::vector<std::string_view> invalid = {"::2", "1:2:3:4:5:6:7:8:9"};
+    EXPECT_THROW(col.AppendStrings(invalid), ValidationError);
+    EXPECT_EQ(texts.size() + 1, col.Size());
+}
+
+TEST(ColumnsCase, ColumnIPv6_Strings_MatchLibc)
+{
+    std::mt19937_64 random(42);
+
+    // Addresses with runs of zero groups of various lengths and positions, IPv4-mapped and IPv4-compatible ones.
+    std::vector<std::string> texts;
+    for (size_t i = 0; i < 10000; ++i) {
+        in6_addr address;
+        for (size_t j = 0; j < 16; j += 2) {
+            const auto kind = random() % 4;
+            const auto group = kind == 0 ? 0 : kind == 1 ? random() % 16 : random();
+            address.s6_addr[j] = static_cast<uint8_t>(group >> 8);
+            address.s6_addr[j + 1] = static_cast<uint8_t>(group);
+        }
+        if (i % 10 == 0) {
+            std::memset(address.s6_addr, 0, 10);
+            address.s6_addr[10] = address.s6_addr[11] = i % 20 == 0 ? 0xff : 0;
+        }
+
+        char buffer[INET6_ADDRSTRLEN];
+        ASSERT_NE(nullptr, inet_ntop(AF_INET6, &address, buffer, sizeof(buffer)));
+        texts.push_back(buffer);
+    }
+
+    ColumnIPv6 col;
+    col.AppendStrings(std::vector<std::string_view>(texts.begin(), texts.end()));
+    ColumnString strings;
+    col.ToStrings(strings);
+    ASSERT_EQ(texts.size(), strings.Size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        ASSERT_EQ(texts[i], strings.At(i));
+    }
+
+    // Parser accepts exactly what inet_pton does.
+    const std::string alphabet = "0123456789abcdefABCDEFg:.";
+    std::vector<std::string> candidates = {"", ":", "::", ":::", "1::2::3", "1:2:3:4:5:6:7::", "1:2:3:4:5:6:7:8::", "::1.2.3.4",
+        "::1.2.3.04", "::1.2.3.256", "::1.2.3", "1.2.3.4", "::ffff:1.2.3.4:1", "12345::", "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7:1.2.3.4", ":1::"};
+    for (size_t i = 0; i < 100000; ++i) {
+        std::string candidate;
+        // Mutations of valid addresses, or completely random strings.
+        if (i % 2 == 0) {
+            candidate = texts[i % texts.size()];
+            candidate[random() % candidate.size()] = alphabet[random() % alphabet.size()];
+        } else {
+            const size_t size = random() % 16;
+            for (size_t j = 0; j < size; ++j) {
+                candidate.push_back(alphabet[random() % alphabet.size()]);
+            }
+        }
+        candidates.push_back(candidate);
+    }
+
+    for (const auto & candidate : candidates) {
+        in6_addr expected;
+        const bool is_valid = inet_pton(AF_INET6, candidate.c_str(), &expected) == 1;
+
+        ColumnIPv6 parsed;
+        if (is_valid) {
+            ASSERT_NO_THROW(parsed.Append(candidate)) << candidate;
+            ASSERT_EQ(expected, parsed.At(0)) << candidate;
+        } else {
+            ASSERT_THROW(parsed.Append(candidate), ValidationError) << candidate;
+        }
+    }
+}
+
 TEST(ColumnsCase, ColumnDecimal256_from_string) {
     auto col = std::make_shared<ColumnDecimal>(76, 0);
 
@@ -711,6 +1554,119 @@ TEST(ColumnsCase, ColumnDecimal256_from_string_overflow) {
 #endif
 }
 
+TEST(ColumnsCase, ColumnDecimal_from_string_long) {
+    auto col = std::make_shared<ColumnDecimal>(38, 2);
+
+    // Parsed in 64 bits up to 19 digits, with Int256 above that.
+    col->Append(std::string("-1.5"));
+    col->Append(std::string("12345678901234567.89"));
+    col->Append(std::string("123456789012345678.9"));
+    col->Append(std::string("-123456789012345678901234567890.12"));
+
+    ASSERT_EQ(4u, col->Size());
+    EXPECT_EQ(Int256(-150), col->At(0));
+    EXPECT_EQ(Int256(1234567890123456789LL), col->At(1));
+    EXPECT_EQ(Int256(1234567890123456789LL) * 10, col->At(2));
+    EXPECT_EQ(-(Int256(1234567890123456789LL) * Int256(10000000000000LL) + Int256(123456789012LL)), col->At(3));
+}
+
+TEST(ColumnsCase, ColumnDecimal_AppendDoubles) {
+    // Long enough for both SIMD loops and scalar tails.
+    std::vector<double> values;
+    for (int i = 0; i < 1001; ++i) {
+        values.push_back(i * 0.01 - 5);
+    }
+    values.push_back(0.29);
+    values.push_back(-1.255e3);
+
+    for (size_t precision : {9, 18, 38, 76}) {
+        SCOPED_TRACE(::testing::Message() << "precision: " << precision);
+        auto col = std::make_shared<ColumnDecimal>(precision, 2);
+        col->Append(Int256(7));
+        col->AppendDoubles(values);
+
+        ASSERT_EQ(values.size() + 1, col->Size());
+        EXPECT_EQ(Int256(7), col->At(0));
+        for (int i = 0; i < 1001; ++i) {
+            ASSERT_EQ(Int256(i - 500), col->At(static_cast<size_t>(i) + 1));
+        }
+        EXPECT_EQ(Int256(29), col->At(1002));
+        EXPECT_EQ(Int256(-125500), col->At(1003));
+
+        std::vector<double> doubles(col->Size());
+        col->ToDoubles(doubles);
+        EXPECT_EQ(0.07, doubles[0]);
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_NEAR(values[i], doubles[i + 1], 1e-9);
+        }
+        EXPECT_EQ(0.29, doubles[1002]);
+
+        EXPECT_THROW(col->ToDoubles(values), ValidationError);
+    }
+}
+
+TEST(ColumnsCase, ColumnDecimal_AppendDoubles_OutOfRange) {
+    auto col = std::make_shared<ColumnDecimal>(9, 2);
+    col->AppendDoubles(std::vector<double>{9999999.99, -9999999.99});
+
+    // Rejected values leave the column unchanged.
+    EXPECT_THROW(col->AppendDoubles(std::vector<double>{1.0, 2.0, 1e7}), ValidationError);
+    EXPECT_THROW(col->AppendDoubles(std::vector<double>{9999999.996}), ValidationError);
+    EXPECT_THROW(col->AppendDoubles(std::vector<double>{1.0, std::nan("")}), ValidationError);
+    EXPECT_THROW(col->AppendDoubles(std::vector<double>{-std::numeric_limits<double>::infinity()}), ValidationError);
+    ASSERT_EQ(2u, col->Size());
+    EXPECT_EQ(Int256(999999999), col->At(0));
+    EXPECT_EQ(Int256(-999999999), col->At(1));
+
+    // Beyond 2^51 Decimal64 values are converted exactly.
+    auto col64 = std::make_shared<ColumnDecimal>(18, 2);
+    col64->AppendDoubles(std::vector<double>{1.0, 1e15, -2.5e15});
+    ASSERT_EQ(3u, col64->Size());
+    EXPECT_EQ(Int256(100), col64->At(0));
+    EXPECT_EQ(Int256(100000000000000000LL), col64->At(1));
+    EXPECT_EQ(Int256(-250000000000000000LL), col64->At(2));
+    EXPECT_THROW(col64->AppendDoubles(std::vector<double>{1e16}), ValidationError);
+    EXPECT_EQ(3u, col64->Size());
+}
+
+TEST(ColumnsCase, ColumnDecimal_AppendIntegers) {
+    auto col32 = std::make_shared<ColumnDecimal>(9, 2);
+    col32->AppendIntegers(std::vector<int64_t>{42, -7, 9999999});
+    EXPECT_THROW(col32->AppendIntegers(std::vector<int64_t>{1, 10000000}), ValidationError);
+    ASSERT_EQ(3u, col32->Size());
+    EXPECT_EQ(Int256(4200), col32->At(0));
+    EXPECT_EQ(Int256(-700), col32->At(1));
+    EXPECT_EQ(Int256(999999900), col32->At(2));
+
+    auto col64 = std::make_shared<ColumnDecimal>(18, 3);
+    col64->AppendIntegers(std::vector<int64_t>{-1, 999999999999999});
+    EXPECT_THROW(col64->AppendIntegers(std::vector<int64_t>{std::numeric_limits<int64_t>::min()}), ValidationError);
+    ASSERT_EQ(2u, col64->Size());
+    EXPECT_EQ(Int256(-1000), col64->At(0));
+    EXPECT_EQ(Int256(999999999999999000LL), col64->At(1));
+
+    auto col128 = std::make_shared<ColumnDecimal>(38, 10);
+    col128->AppendIntegers(std::vector<int64_t>{std::numeric_limits<int64_t>::max()});
+    EXPECT_EQ(Int256(std::numeric_limits<int64_t>::max()) * Int256(10000000000LL), col128->At(0));
+}
+
+TEST(ColumnsCase, ColumnDecimal_AppendUnscaled) {
+    for (size_t precision : {9, 18, 38, 76}) {
+        SCOPED_TRACE(::testing::Message() << "precision: " << precision);
+        auto col = std::make_shared<ColumnDecimal>(precision, 2);
+        col->AppendUnscaled(std::vector<int64_t>{4200, -999999999, 0});
+
+        ASSERT_EQ(3u, col->Size());
+        EXPECT_EQ(Int256(4200), col->At(0));
+        EXPECT_EQ(Int256(-999999999), col->At(1));
+        EXPECT_EQ(Int256(0), col->At(2));
+    }
+
+    auto col = std::make_shared<ColumnDecimal>(9, 2);
+    EXPECT_THROW(col->AppendUnscaled(std::vector<int64_t>{1, 1000000000}), ValidationError);
+    EXPECT_EQ(0u, col->Size());
+}
+
 TEST(ColumnsCase, ColumnLowCardinalityString_Append_and_Read) {
     const size_t items_count = 11;
     ColumnLowCardinalityT<ColumnString> col;
@@ -748,6 +1704,307 @@ TEST(ColumnsCase, ColumnLowCardinalityString_Clear_and_Append) {
     ASSERT_EQ(col.GetDictionarySize(), 8u + 1); // 8 unique items from sequence + 1 null-item
 }
 
+TEST(ColumnsCase, ColumnLowCardinalityString_DictionaryCache) {
+    ColumnLowCardinalityT<ColumnString> col;
+    col.SetDictionaryCacheLimit(100);
+
+    for (size_t i = 0; i < 10; ++i) {
+        col.Append("item_" + std::to_string(i));
+    }
+    ASSERT_EQ(col.GetDictionarySize(), 10u + 1);
+
+    // Dictionary survives Clear() ...
+    col.Clear();
+    ASSERT_EQ(col.Size(), 0u);
+    ASSERT_EQ(col.GetDictionarySize(), 10u + 1);
+
+    // ... and is reused by the next block, which only adds new values.
+    const std::vector<std::string> values = {"item_9", "item_3", "new", "item_9", ""};
+    for (const auto & v : values) {
+        col.Append(v);
+    }
+    ASSERT_EQ(col.GetDictionarySize(), 11u + 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(i), values[i]) << " at pos: " << i;
+    }
+
+    // Only values of current rows are sent.
+    Buffer buffer;
+    {
+        BufferOutput output(&buffer);
+        col.Save(&output);
+    }
+
+    ColumnLowCardinalityT<ColumnString> loaded;
+    ArrayInput input(buffer.data(), buffer.size());
+    ASSERT_TRUE(loaded.Load(&input, values.size()));
+    ASSERT_EQ(loaded.GetDictionarySize(), 3u + 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(loaded.At(i), values[i]) << " at pos: " << i;
+    }
+
+    // Dictionary that outgrew the limit is dropped.
+    for (size_t i = 0; i < 100; ++i) {
+        col.Append("other_" + std::to_string(i));
+    }
+    col.Clear();
+    ASSERT_EQ(col.GetDictionarySize(), 1u);
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_DictionaryCache_FullyUsed) {
+    ColumnLowCardinalityT<ColumnString> col;
+    col.SetDictionaryCacheLimit(100);
+    const std::vector<std::string> values = {"b", "a", "b", "c"};
+    for (const auto & v : values) {
+        col.Append(v);
+    }
+
+    // Every cached item is used, so the dictionary is sent as is, the same as without the cache.
+    ColumnLowCardinalityT<ColumnString> plain;
+    for (const auto & v : values) {
+        plain.Append(v);
+    }
+
+    Buffer cached_body, plain_body;
+    {
+        BufferOutput output(&cached_body);
+        col.Save(&output);
+    }
+    {
+        BufferOutput output(&plain_body);
+        plain.Save(&output);
+    }
+    EXPECT_EQ(plain_body, cached_body);
+
+    // Cache setting moves along with the data.
+    plain.Swap(col);
+    EXPECT_EQ(100u, plain.GetDictionaryCacheLimit());
+    EXPECT_EQ(0u, col.GetDictionaryCacheLimit());
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityNullableString_DictionaryCache) {
+    ColumnLowCardinalityT<ColumnNullableT<ColumnString>> col;
+    col.SetDictionaryCacheLimit(100);
+
+    col.Append(std::string("a"));
+    col.Append(std::string("b"));
+    col.Clear();
+
+    const std::vector<std::optional<std::string>> values = {"b", std::nullopt, "", "b"};
+    for (const auto & v : values) {
+        col.Append(v);
+    }
+
+    Buffer buffer;
+    {
+        BufferOutput output(&buffer);
+        col.Save(&output);
+    }
+
+    ColumnLowCardinalityT<ColumnNullableT<ColumnString>> loaded;
+    ArrayInput input(buffer.data(), buffer.size());
+    ASSERT_TRUE(loaded.Load(&input, values.size()));
+    // null, default and "b"
+    ASSERT_EQ(loaded.GetDictionarySize(), 3u);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(loaded.At(i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_DictionaryEncodedAccess) {
+    ColumnLowCardinalityT<ColumnString> col;
+    const auto values = GenerateVector(20, &FooBarGenerator);
+    col.AppendMany(values);
+
+    const auto & dictionary = col.GetTypedDictionary();
+    ASSERT_EQ(col.GetDictionaryColumn()->Size(), dictionary.Size());
+    ASSERT_EQ(col.GetIndexType(), Type::UInt32);
+
+    const auto indexes = col.GetIndexes<uint32_t>();
+    ASSERT_EQ(indexes.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(dictionary[indexes[i]], values[i]) << " at pos: " << i;
+    }
+
+    size_t visited = 0;
+    col.VisitIndexes([&](auto visited_indexes) {
+        for (const auto index : visited_indexes) {
+            EXPECT_EQ(dictionary[index], values[visited]) << " at pos: " << visited;
+            ++visited;
+        }
+    });
+    EXPECT_EQ(visited, values.size());
+
+    EXPECT_THROW(col.GetIndexes<uint8_t>(), ValidationError);
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendAfterLoad) {
+    const auto values = GenerateVector(10, &FooBarGenerator);
+    Buffer buffer;
+    {
+        ColumnLowCardinalityT<ColumnString> col;
+        col.AppendMany(values);
+        BufferOutput output(&buffer);
+        col.Save(&output);
+    }
+
+    ColumnLowCardinalityT<ColumnString> col;
+    ArrayInput input(buffer.data(), buffer.size());
+    ASSERT_TRUE(col.Load(&input, values.size()));
+    const auto dictionary_size = col.GetDictionarySize();
+
+    // Values already in the loaded dictionary are found there, new ones are added.
+    col.Append(values[3]);
+    EXPECT_EQ(col.GetDictionarySize(), dictionary_size);
+    col.Append("definitely new value");
+    EXPECT_EQ(col.GetDictionarySize(), dictionary_size + 1);
+
+    EXPECT_EQ(col.At(values.size()), values[3]);
+    EXPECT_EQ(col.At(values.size() + 1), "definitely new value");
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendColumn) {
+    ColumnLowCardinalityT<ColumnString> col;
+    std::vector<std::string> expected;
+
+    for (size_t block = 0; block < 5; ++block) {
+        auto other = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+        // Not used by any row, must not be added to dictionary.
+        other->SetDictionaryCacheLimit(10);
+        other->Append("unused");
+        other->Clear();
+
+        for (size_t i = 0; i < 20; ++i) {
+            // Overlapping sets of values, so that some are found in dictionary and some are new.
+            expected.push_back(i % 7 == 0 ? std::string() : "value_" + std::to_string((block * 20 + i) % 30));
+            other->Append(expected.back());
+        }
+
+        col.Append(other);
+    }
+
+    // Column of the dictionary type
+    auto strings = std::make_shared<ColumnString>(std::vector<std::string>{"value_0", "plain"});
+    col.Append(strings);
+    expected.push_back("value_0");
+    expected.push_back("plain");
+
+    // Self
+    const auto size = col.Size();
+    auto self = std::shared_ptr<Column>(&col, [](Column*) {});
+    col.Append(self);
+    ASSERT_EQ(size * 2, col.Size());
+    const auto first_half = expected;
+    expected.insert(expected.end(), first_half.begin(), first_half.end());
+
+    ASSERT_EQ(expected.size(), col.Size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], col.At(i)) << " at pos: " << i;
+    }
+    // default item + value_0 .. value_29 + plain
+    EXPECT_EQ(1u + 30 + 1, col.GetDictionarySize());
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityNullableString_AppendColumn) {
+    using LCColumn = ColumnLowCardinalityT<ColumnNullableT<ColumnString>>;
+    LCColumn col;
+    col.Append(std::string("a"));
+
+    auto other = std::make_shared<LCColumn>();
+    const std::vector<std::optional<std::string>> values = {std::nullopt, "b", "", "a", std::nullopt, "b"};
+    other->AppendMany(values);
+    col.Append(other);
+
+    ASSERT_EQ(values.size() + 1, col.Size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], col.At(i + 1)) << " at pos: " << i;
+    }
+    // null, default, "a" and "b"
+    EXPECT_EQ(4u, col.GetDictionarySize());
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_EmptyLoadedDictionary) {
+    // Body of zero rows with no dictionary items at all, as the server may send it.
+    Buffer buffer;
+    {
+        BufferOutput output(&buffer);
+        WireFormat::WriteFixed<uint64_t>(output, 1);            // key version
+        WireFormat::WriteFixed<uint64_t>(output, 1ull << 9);    // UInt8 index, HasAdditionalKeysBit
+        WireFormat::WriteFixed<uint64_t>(output, 0);            // number of keys
+        WireFormat::WriteFixed<uint64_t>(output, 0);            // number of rows
+    }
+
+    auto empty = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    ArrayInput input(buffer.data(), buffer.size());
+    ASSERT_TRUE(empty->Load(&input, 0));
+    ASSERT_EQ(0u, empty->GetDictionarySize());
+
+    ColumnLowCardinalityT<ColumnString> col;
+    col.Append("a");
+    col.Append(empty);
+    EXPECT_EQ(1u, col.Size());
+
+    empty->SetDictionaryCacheLimit(10);
+    Buffer saved;
+    BufferOutput output(&saved);
+    EXPECT_NO_THROW(empty->Save(&output));
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendColumn_WidensIndex) {
+    // Server sends the narrowest index type possible, while columns built by client use UInt32 one.
+    auto load = [](const std::vector<std::string> & values) {
+        Buffer buffer;
+        {
+            ColumnLowCardinalityT<ColumnString> col;
+            col.AppendMany(values);
+            BufferOutput output(&buffer);
+            col.Save(&output);
+        }
+
+        // Serialized as: key version, index type, dictionary size, dictionary, rows count, indexes.
+        std::vector<uint8_t> narrowed(buffer.begin(), buffer.end() - values.size() * sizeof(uint32_t));
+        uint64_t index_type;
+        std::memcpy(&index_type, narrowed.data() + sizeof(uint64_t), sizeof(index_type));
+        EXPECT_EQ(2u, index_type & 0xff);
+        index_type &= ~uint64_t(0xff);
+        std::memcpy(narrowed.data() + sizeof(uint64_t), &index_type, sizeof(index_type));
+
+        const auto indexes = buffer.data() + narrowed.size();
+        for (size_t i = 0; i < values.size(); ++i) {
+            uint32_t index;
+            std::memcpy(&index, indexes + i * sizeof(index), sizeof(index));
+            narrowed.push_back(static_cast<uint8_t>(index));
+        }
+
+        auto col = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+        ArrayInput input(narrowed.data(), narrowed.size());
+        EXPECT_TRUE(col->Load(&input, values.size()));
+        EXPECT_EQ(Type::UInt8, col->GetIndexType());
+        return col;
+    };
+
+    std::vector<std::string> first, second;
+    for (size_t i = 0; i < 200; ++i) {
+        first.push_back("first_" + std::to_string(i));
+        second.push_back("second_" + std::to_string(i));
+    }
+
+    auto col = load(first);
+    col->Append(load(second));
+    EXPECT_EQ(Type::UInt16, col->GetIndexType());
+    ASSERT_EQ(400u, col->Size());
+    for (size_t i = 0; i < 200; ++i) {
+        EXPECT_EQ(first[i], col->At(i));
+        EXPECT_EQ(second[i], col->At(i + 200));
+    }
+
+    // Same when appending values one by one.
+    col = load(first);
+    col->AppendMany(second);
+    EXPECT_EQ(Type::UInt16, col->GetIndexType());
+    EXPECT_EQ(second.back(), col->At(399));
+}
+
 TEST(ColumnsCase, ColumnLowCardinalityString_Load) {
     const size_t items_count = 10;
     ColumnLowCardinalityT<ColumnString> col;
@@ -922,6 +2179,263 @@ TEST(ColumnsCase, ColumnTupleT_Empty) {
     EXPECT_EQ(col.Size(), 0u);
 }
 
+TEST(ColumnsCase, ByteSize) {
+    auto numbers = std::make_shared<ColumnInt32>(std::vector<int32_t>{1, 2, 3, 4});
+    EXPECT_EQ(4 * sizeof(int32_t), numbers->ByteSize());
+    numbers->Reserve(100);
+    EXPECT_EQ(4 * sizeof(int32_t), numbers->ByteSize());
+    EXPECT_EQ(100 * sizeof(int32_t), numbers->AllocatedBytes());
+
+    // Slice shares memory with the column, whole allocation of which is counted by both of them.
+    const auto slice = numbers->Slice(1, 2);
+    EXPECT_EQ(2 * sizeof(int32_t), slice->ByteSize());
+    EXPECT_EQ(numbers->AllocatedBytes(), slice->AllocatedBytes());
+    EXPECT_EQ(numbers->AllocatedBytes(), slice->Slice(1, 1)->AllocatedBytes());
+
+    auto fixed_strings = std::make_shared<ColumnFixedString>(10);
+    fixed_strings->Reserve(100);
+    fixed_strings->Append("a");
+    EXPECT_EQ(10u, fixed_strings->ByteSize());
+    EXPECT_LE(1000u, fixed_strings->AllocatedBytes());
+    EXPECT_LE(fixed_strings->AllocatedBytes(), fixed_strings->Slice(0, 1)->AllocatedBytes());
+
+    auto compact_strings = std::make_shared<ColumnString>(ColumnString::Layout::Compact);
+    compact_strings->Reserve(100);
+    compact_strings->Append("hello");
+    compact_strings->Append("world");
+    EXPECT_EQ(2 * sizeof(uint64_t) + 10, compact_strings->ByteSize());
+    EXPECT_EQ(sizeof(uint64_t) + 5, compact_strings->Slice(1, 1)->ByteSize());
+    EXPECT_EQ(compact_strings->AllocatedBytes(), compact_strings->Slice(1, 1)->AllocatedBytes());
+
+    auto strings = std::make_shared<ColumnString>();
+    strings->Append("hello");
+    strings->Append(std::string(1000, 'x'));
+    EXPECT_EQ(2 * sizeof(std::string_view) + 1005, strings->ByteSize());
+    EXPECT_LE(strings->ByteSize(), strings->AllocatedBytes());
+    const auto allocated = strings->AllocatedBytes();
+    strings->Clear();
+    EXPECT_EQ(0u, strings->ByteSize());
+    // Storage blocks are retained for reuse.
+    EXPECT_LE(1005u, allocated);
+    EXPECT_LT(0u, strings->AllocatedBytes());
+
+    auto nullable = std::make_shared<ColumnNullable>(numbers, std::make_shared<ColumnUInt8>(std::vector<uint8_t>{0, 1, 0, 0}));
+    EXPECT_EQ(4 * sizeof(int32_t) + 4, nullable->ByteSize());
+
+    auto array = std::make_shared<ColumnArrayT<ColumnInt32>>();
+    array->Append(std::vector<int32_t>{1, 2, 3});
+    array->Append(std::vector<int32_t>{});
+    EXPECT_EQ(3 * sizeof(int32_t) + 2 * sizeof(uint64_t), array->ByteSize());
+
+    auto low_cardinality = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    const auto empty_size = low_cardinality->ByteSize();
+    const auto empty_allocated = low_cardinality->AllocatedBytes();
+    for (size_t i = 0; i < 1000; ++i) {
+        low_cardinality->Append(i % 2 ? "odd" : "even");
+    }
+    // Two new dictionary items and 1000 indexes, of 1 to 8 bytes each.
+    EXPECT_LE(empty_size + 2 * sizeof(std::string_view) + 7 + 1000, low_cardinality->ByteSize());
+    EXPECT_GE(empty_size + 2 * sizeof(std::string_view) + 7 + 8000, low_cardinality->ByteSize());
+    EXPECT_LT(empty_allocated, low_cardinality->AllocatedBytes());
+    EXPECT_LE(low_cardinality->ByteSize(), low_cardinality->AllocatedBytes());
+
+    auto tuple = std::make_shared<ColumnTuple>(std::vector<ColumnRef>{numbers, strings});
+    EXPECT_EQ(numbers->ByteSize() + strings->ByteSize(), tuple->ByteSize());
+
+    ColumnUUID uuids;
+    uuids.Append(UUID{1, 2});
+    EXPECT_EQ(16u, uuids.ByteSize());
+}
+
+TEST(ColumnsCase, ColumnTupleT_AppendRows) {
+    using TestTuple = ColumnTupleT<ColumnUInt64, ColumnString, ColumnFloat64>;
+    TestTuple col(std::make_tuple(
+        std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>(), std::make_shared<ColumnFloat64>()));
+
+    const std::vector<uint64_t> ids{1, 2, 3};
+    const std::vector<std::string_view> names{"one", "two", "three"};
+    const std::vector<double> weights{0.5, 1.5, 2.5};
+
+    size_t tasks_run = 0;
+    const ParallelExecutor executor = [&tasks_run] (size_t count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; ++i) {
+            threads.emplace_back(task, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        tasks_run += count;
+    };
+
+    col.Append(std::make_tuple(0u, "zero", 0.0));
+    col.AppendRows({ids, names, weights});
+    col.AppendRows({ids, names, weights}, executor, 5);
+    EXPECT_EQ(3u, tasks_run);
+
+    ASSERT_EQ(7u, col.Size());
+    EXPECT_EQ(std::make_tuple(uint64_t{2}, std::string_view("two"), 1.5), col.At(2));
+    EXPECT_EQ(std::make_tuple(uint64_t{3}, std::string_view("three"), 2.5), col.At(6));
+
+    const auto& [id_column, name_column, weight_column] = col.GetColumns();
+    EXPECT_EQ(&col.GetColumn<1>(), &name_column);
+    EXPECT_EQ(7u, id_column.Size());
+    EXPECT_EQ("one", name_column.At(4));
+    EXPECT_EQ(0.5, weight_column.At(4));
+
+    EXPECT_THROW(col.AppendRows({ids, names, std::vector<double>{1.0}}), ValidationError);
+    EXPECT_EQ(7u, col.Size());
+    EXPECT_EQ(7u, col.GetColumn<0>().Size());
+
+    col.Clear();
+    EXPECT_EQ(0u, col.Size());
+    EXPECT_EQ(3u, col.TupleSize());
+    col.AppendRows({ids, names, weights});
+    EXPECT_EQ(std::make_tuple(uint64_t{1}, std::string_view("one"), 0.5), col.At(0));
+}
+
+TEST(ColumnsCase, ColumnTupleT_AppendRowsFailure) {
+    using TestTuple = ColumnTupleT<ColumnUInt64, ColumnFixedString, ColumnFloat64>;
+    TestTuple col(std::make_tuple(
+        std::make_shared<ColumnUInt64>(), std::make_shared<ColumnFixedString>(2), std::make_shared<ColumnFloat64>()));
+    col.AppendRows({std::vector<uint64_t>{1}, std::vector<std::string_view>{"ab"}, std::vector<double>{0.5}});
+
+    const ParallelExecutor executor = [] (size_t count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; ++i) {
+            threads.emplace_back(task, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    // Second item is too long for FixedString(2), other elements are filled by then.
+    const std::vector<uint64_t> ids{2, 3, 4};
+    const std::vector<std::string_view> codes{"cd", "efg", "h"};
+    const std::vector<double> weights{1.5, 2.5, 3.5};
+    for (size_t workers : {1, 3}) {
+        SCOPED_TRACE(workers);
+        EXPECT_THROW(col.AppendRows({ids, codes, weights}, executor, workers), ValidationError);
+
+        const auto& [id_column, code_column, weight_column] = col.GetColumns();
+        EXPECT_EQ(1u, col.Size());
+        EXPECT_EQ(1u, id_column.Size());
+        EXPECT_EQ(1u, code_column.Size());
+        EXPECT_EQ(1u, weight_column.Size());
+    }
+
+    col.AppendRows({ids, std::vector<std::string_view>{"cd", "ef", "h"}, weights});
+    ASSERT_EQ(4u, col.Size());
+    EXPECT_EQ(std::make_tuple(uint64_t{1}, std::string_view("ab"), 0.5), col.At(0));
+    EXPECT_EQ(std::make_tuple(uint64_t{3}, std::string_view("ef"), 2.5), col.At(2));
+}
+
+TEST(ColumnsCase, ColumnTupleT_GetSpans) {
+    using TestTuple = ColumnTupleT<ColumnInt32, ColumnFloat64>;
+    TestTuple col(std::make_tuple(std::make_shared<ColumnInt32>(), std::make_shared<ColumnFloat64>()));
+    col.AppendRows({std::vector<int32_t>{1, 2, 3}, std::vector<double>{0.1, 0.2, 0.3}});
+
+    const auto [ints, doubles] = col.GetSpans();
+    ASSERT_EQ(3u, ints.size());
+    ASSERT_EQ(3u, doubles.size());
+    EXPECT_EQ(2, ints[1]);
+    EXPECT_EQ(0.3, doubles[2]);
+    EXPECT_EQ(col.GetColumn<0>().GetData().data(), ints.data());
+}
+
+TEST(ColumnsCase, ColumnPolygon_AppendFlat) {
+    // Square, then triangle with triangular hole, then empty polygon.
+    const std::vector<double> x{0, 0, 1, 1, 0,  0, 4, 2, 0,  1, 3, 2, 1};
+    const std::vector<double> y{0, 1, 1, 0, 0,  0, 0, 4, 0,  1, 1, 2, 1};
+    const std::vector<uint64_t> rings{5, 9, 13};
+    const std::vector<uint64_t> rows{1, 3, 3};
+
+    ColumnPolygon col;
+    col.Append(std::vector<std::vector<ColumnPoint::ValueType>>{{{9.0, 9.0}}});
+    col.AppendFlat(x, y, {rows, rings});
+
+    ASSERT_EQ(4u, col.Size());
+    EXPECT_EQ(4u, col.RingCount());
+    EXPECT_EQ(14u, col.GetPoints().size());
+
+    for (size_t row = 1; row < col.Size(); ++row) {
+        const auto polygon = col.At(row);
+        const auto [first, last] = col.GetRowRings(row);
+        ASSERT_EQ(polygon.size(), last - first);
+
+        for (size_t r = 0; r < polygon.size(); ++r) {
+            const auto ring = col.GetRing(first + r);
+            ASSERT_EQ(polygon[r].size(), ring.size());
+            for (size_t i = 0; i < ring.size(); ++i) {
+                EXPECT_EQ(polygon[r][i], ring[i]);
+            }
+        }
+    }
+
+    const auto hole = col.GetRing(3);
+    EXPECT_EQ(4u, hole.size());
+    EXPECT_EQ(std::make_tuple(3.0, 1.0), hole[1]);
+    EXPECT_EQ(std::make_pair(size_t{4}, size_t{4}), col.GetRowRings(3));
+
+    EXPECT_THROW(col.GetRing(4), ValidationError);
+    EXPECT_THROW(col.GetRowRings(4), ValidationError);
+}
+
+TEST(ColumnsCase, ColumnMultiPolygon_AppendFlat) {
+    const std::vector<double> x{0, 1, 2, 0,  5, 6, 7, 5,  8, 9, 8};
+    const std::vector<double> y{0, 1, 0, 0,  5, 6, 5, 5,  8, 9, 8};
+
+    ColumnMultiPolygon col;
+    col.AppendFlat(x, y, {std::vector<uint64_t>{2, 3}, std::vector<uint64_t>{1, 3, 3}, std::vector<uint64_t>{4, 8, 11}});
+
+    ASSERT_EQ(2u, col.Size());
+    EXPECT_EQ(3u, col.RingCount());
+    EXPECT_EQ(std::make_pair(size_t{0}, size_t{3}), col.GetRowRings(0));
+    EXPECT_EQ(std::make_pair(size_t{3}, size_t{3}), col.GetRowRings(1));
+
+    const auto multi_polygon = col.At(0);
+    ASSERT_EQ(2u, multi_polygon.size());
+    EXPECT_EQ(1u, multi_polygon[0].size());
+    EXPECT_EQ(2u, multi_polygon[1].size());
+    ASSERT_EQ(1u, col.At(1).size());
+    EXPECT_EQ(0u, col.At(1)[0].size());
+    EXPECT_EQ(std::make_tuple(9.0, 9.0), multi_polygon[1][1][1]);
+    EXPECT_EQ(std::make_tuple(9.0, 9.0), col.GetRing(2)[1]);
+
+    ColumnRing rings;
+    rings.AppendFlat(x, y, {std::vector<uint64_t>{4, 8, 11}});
+    ASSERT_EQ(3u, rings.Size());
+    EXPECT_EQ(3u, rings.GetRing(2).size());
+    EXPECT_EQ(std::make_tuple(6.0, 6.0), rings.At(1)[1]);
+
+    ColumnPoint points;
+    points.AppendFlat(x, y);
+    ASSERT_EQ(x.size(), points.Size());
+    EXPECT_EQ(std::make_tuple(7.0, 5.0), points.At(6));
+}
+
+TEST(ColumnsCase, ColumnPolygon_AppendFlat_Invalid) {
+    const std::vector<double> x{0, 1, 2, 3};
+    const std::vector<double> y{0, 1, 2, 3};
+
+    ColumnPolygon col;
+    col.AppendFlat(x, y, {std::vector<uint64_t>{1}, std::vector<uint64_t>{4}});
+
+    // Coordinates count mismatch.
+    EXPECT_THROW(col.AppendFlat(x, std::vector<double>{0, 1}, {std::vector<uint64_t>{1}, std::vector<uint64_t>{4}}), ValidationError);
+    // Rings don't cover all points.
+    EXPECT_THROW(col.AppendFlat(x, y, {std::vector<uint64_t>{1}, std::vector<uint64_t>{3}}), ValidationError);
+    // Decreasing offsets.
+    EXPECT_THROW(col.AppendFlat(x, y, {std::vector<uint64_t>{2}, std::vector<uint64_t>{3, 2, 4}}), ValidationError);
+    // Rows refer to more rings than there are, checked after rings that are fine.
+    EXPECT_THROW(col.AppendFlat(x, y, {std::vector<uint64_t>{2}, std::vector<uint64_t>{4}}), ValidationError);
+
+    ASSERT_EQ(1u, col.Size());
+    EXPECT_EQ(1u, col.RingCount());
+    EXPECT_EQ(4u, col.GetPoints().size());
+}
+
 TEST(ColumnsCase, ColumnMapT) {
     ColumnMapT<ColumnUInt64, ColumnString> col(
             std::make_shared<ColumnUInt64>(),
@@ -972,3 +2486,90 @@ TEST(ColumnsCase, ColumnMapT_Wrap) {
     EXPECT_EQ("123", map_view.At(1));
     EXPECT_EQ("abc", map_view.At(2));
 }
+
+TEST(ColumnsCase, ColumnMapT_AppendRows) {
+    using TestMap = ColumnMapT<ColumnUInt64, ColumnString>;
+    TestMap col(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>());
+
+    col.Append(std::map<uint64_t, std::string>{{7, "seven"}});
+    col.AppendRow(std::vector<uint64_t>{1, 2}, std::vector<std::string_view>{"one", "two"});
+    col.AppendRows(std::vector<uint64_t>{0, 3}, std::vector<uint64_t>{3, 4, 3}, std::vector<std::string_view>{"a", "b", "c"});
+
+    ASSERT_EQ(4u, col.Size());
+    EXPECT_EQ("seven", col.At(0).At(7));
+    EXPECT_EQ("two", col.At(1).At(2));
+    EXPECT_EQ(0u, col.At(2).Size());
+    EXPECT_EQ("b", col.At(3).At(4));
+    EXPECT_EQ("a", col.At(3).At(3));
+
+    EXPECT_EQ(std::make_pair(size_t{3}, size_t{6}), col.GetRowRange(3));
+    EXPECT_EQ(6u, col.GetKeys().Size());
+    EXPECT_EQ(6u, col.GetValues().Size());
+
+    const auto keys = col.RowKeys(1);
+    static_assert(std::is_same_v<std::decay_t<decltype(keys)>, Span<const uint64_t>>);
+    EXPECT_EQ(std::vector<uint64_t>({1, 2}), std::vector<uint64_t>(keys.begin(), keys.end()));
+
+    const auto values = col.RowValues(3);
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ(std::vector<std::string_view>({"a", "b", "c"}), std::vector<std::string_view>(values.begin(), values.end()));
+    EXPECT_TRUE(col.RowValues(2).empty());
+    EXPECT_THROW(col.RowKeys(4), ValidationError);
+
+    // Duplicate key resolves to its first value, as with MapValueView.
+    const auto index = col.IndexRow(3);
+    EXPECT_EQ(2u, index.Size());
+    EXPECT_EQ(std::optional<std::string_view>("a"), index.Find(3));
+    EXPECT_EQ(col.At(3).At(3), *index.Find(3));
+    EXPECT_TRUE(index.Contains(4));
+    EXPECT_EQ(std::nullopt, index.Find(1));
+
+    EXPECT_THROW(col.AppendRow(std::vector<uint64_t>{1}, std::vector<std::string_view>{}), ValidationError);
+    EXPECT_THROW(col.AppendRows(std::vector<uint64_t>{2}, std::vector<uint64_t>{1}, std::vector<std::string_view>{"x"}), ValidationError);
+    EXPECT_EQ(4u, col.Size());
+    EXPECT_EQ(6u, col.GetKeys().Size());
+}
+
+TEST(ColumnsCase, ColumnMapT_AppendRowsFailure) {
+    using TestMap = ColumnMapT<ColumnUInt64, ColumnFixedString>;
+    TestMap col(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnFixedString>(2));
+    col.AppendRow(std::vector<uint64_t>{1}, std::vector<std::string_view>{"ab"});
+
+    // Keys are appended before a value turns out to be too long for FixedString(2).
+    EXPECT_THROW(col.AppendRow(std::vector<uint64_t>{2, 3}, std::vector<std::string_view>{"cd", "efg"}), ValidationError);
+    EXPECT_THROW(col.AppendRows(std::vector<uint64_t>{1, 2}, std::vector<uint64_t>{2, 3}, std::vector<std::string_view>{"cd", "efg"}),
+        ValidationError);
+    EXPECT_EQ(1u, col.Size());
+    EXPECT_EQ(1u, col.GetKeys().Size());
+    EXPECT_EQ(1u, col.GetValues().Size());
+
+    col.AppendRow(std::vector<uint64_t>{2, 3}, std::vector<std::string_view>{"cd", "ef"});
+    ASSERT_EQ(2u, col.Size());
+    EXPECT_EQ(std::make_pair(size_t{1}, size_t{3}), col.GetRowRange(1));
+    EXPECT_EQ("ef", col.At(1).At(3));
+}
+
+TEST(ColumnsCase, ColumnMapT_StringKeysIndex) {
+    using TestMap = ColumnMapT<ColumnString, ColumnInt32>;
+    TestMap col(std::make_shared<ColumnString>(), std::make_shared<ColumnInt32>());
+
+    std::vector<std::string> names;
+    std::vector<std::string_view> keys;
+    std::vector<int32_t> values;
+    for (int32_t i = 0; i < 50; ++i) {
+        names.push_back("label_" + std::to_string(i));
+        values.push_back(i);
+    }
+    keys.assign(names.begin(), names.end());
+    col.AppendRow(keys, values);
+
+    const auto index = col.IndexRow(0);
+    for (int32_t i = 0; i < 50; ++i) {
+        EXPECT_EQ(std::optional<int32_t>(i), index.Find(keys[static_cast<size_t>(i)]));
+    }
+    EXPECT_FALSE(index.Find("label_50"));
+
+    const auto row_keys = col.RowKeys(0);
+    EXPECT_EQ("label_7", row_keys[7]);
+    EXPECT_EQ(49, col.RowValues(0)[49]);
+}
@@ -1,18 +1,30 @@
 #include <timeplus/columns/array.h>
 #include <timeplus/columns/date.h>
+#include <timeplus/columns/decimal.h>
+#include <timeplus/columns/geo.h>
+#include <timeplus/columns/ip6.h>
 #include <timeplus/columns/enum.h>
 #include <timeplus/columns/lowcardinality.h>
+#include <timeplus/columns/map.h>
 #include <timeplus/columns/nullable.h>
 #include <timeplus/columns/numeric.h>
 #include <timeplus/columns/string.h>
+#include <timeplus/columns/tuple.h>
 #include <timeplus/columns/uuid.h>
 #include <timeplus/client.h>
 #include <timeplus/base/output.h>
 #include <timeplus/base/input.h>
+#include <timeplus/base/socket.h>
+#include <timeplus/base/wire_format.h>
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <string>
+#include <thread>
 
 #include "utils.h"
 #include "utils_performance.h"
@@ -24,6 +36,15 @@ inline std::uint64_t generate(const ColumnUInt64&, size_t index) {
     return base << 7*8 | base << 6*8 | base << 5*8 | base << 4*8 | base << 3*8 | base << 2*8 | base << 1*8 | base;
 }
 
+// Looks like hash-based ids: all limbs are filled.
+inline UInt256 generate(const ColumnUInt256&, size_t index) {
+    UInt256 result;
+    for (size_t i = 0; i < 4; ++i) {
+        result.items[i] = (index + i + 1) * 0x9E3779B97F4A7C15ULL;
+    }
+    return result;
+}
+
 template <size_t RESULT_SIZE=8>
 inline std::string_view generate_string_view(size_t index) {
     static const char result_template[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
@@ -253,10 +274,685 @@ TYPED_TEST_P(ColumnPerformanceTest, InsertAndSelect) {
     }
 }
 
+TEST(ColumnLowCardinalityPerformanceTest, AppendString) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    for (const size_t distinct_count : {10, 1'000, 100'000}) {
+        std::vector<std::string> values;
+        values.reserve(distinct_count);
+        for (size_t i = 0; i < distinct_count; ++i) {
+            values.emplace_back("value_" + std::to_string(i * 7919));
+        }
+
+        ColumnLowCardinalityT<ColumnString> column;
+
+        Timer timer;
+        for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+            column.Append(values[i % distinct_count]);
+        }
+        const auto elapsed = timer.Elapsed();
+
+        EXPECT_EQ(ITEMS_COUNT, column.Size());
+        // +1 for the default item
+        EXPECT_EQ(distinct_count + 1, column.GetDictionarySize());
+
+        std::cerr << "Appending " << ITEMS_COUNT << " items of " << distinct_count
+                  << " distinct values to " << column.Type()->GetName() << ":\t" << elapsed << std::endl;
+    }
+}
+
+TEST(ColumnLowCardinalityPerformanceTest, AppendColumn) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t BLOCKS_COUNT = 1'000;
+    const size_t BLOCK_SIZE = 1'000;
+    const size_t DISTINCT_COUNT = 500;
+
+    std::vector<ColumnRef> blocks;
+    for (size_t block = 0; block < BLOCKS_COUNT; ++block) {
+        auto column = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            column->Append("value_" + std::to_string((block * 31 + i * 7) % DISTINCT_COUNT));
+        }
+        blocks.push_back(column);
+    }
+
+    {
+        // Row by row, as Append(ColumnRef) used to do it.
+        ColumnLowCardinalityT<ColumnString> column;
+        Timer timer;
+        for (const auto & block : blocks) {
+            const auto & typed_block = *block->As<ColumnLowCardinalityT<ColumnString>>();
+            for (size_t i = 0; i < typed_block.Size(); ++i) {
+                column.Append(typed_block.At(i));
+            }
+        }
+        std::cerr << "Appending rows:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(BLOCKS_COUNT * BLOCK_SIZE, column.Size());
+    }
+
+    {
+        ColumnLowCardinalityT<ColumnString> column;
+        Timer timer;
+        for (const auto & block : blocks) {
+            column.Append(block);
+        }
+        std::cerr << "Appending columns:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(BLOCKS_COUNT * BLOCK_SIZE, column.Size());
+        EXPECT_EQ(DISTINCT_COUNT + 1, column.GetDictionarySize());
+    }
+}
+
+TEST(ColumnArrayPerformanceTest, AppendRows) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ROWS_COUNT = 1'000'000;
+    const size_t ITEMS_PER_ROW = 8;
+
+    {
+        ColumnArrayT<ColumnUInt64> column;
+        Timer timer;
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            auto items = std::make_shared<ColumnUInt64>();
+            for (size_t i = 0; i < ITEMS_PER_ROW; ++i) {
+                items->Append(row + i);
+            }
+            column.AppendAsColumn(items);
+        }
+        std::cerr << "AppendAsColumn:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+
+    {
+        ColumnArrayT<ColumnUInt64> column;
+        Timer timer;
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            auto & items = column.BeginRow();
+            for (size_t i = 0; i < ITEMS_PER_ROW; ++i) {
+                items.Append(row + i);
+            }
+            column.EndRow();
+        }
+        std::cerr << "BeginRow/EndRow:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+
+    {
+        std::vector<uint64_t> offsets(ROWS_COUNT);
+        std::vector<uint64_t> values(ROWS_COUNT * ITEMS_PER_ROW);
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            offsets[row] = (row + 1) * ITEMS_PER_ROW;
+            for (size_t i = 0; i < ITEMS_PER_ROW; ++i) {
+                values[row * ITEMS_PER_ROW + i] = row + i;
+            }
+        }
+
+        ColumnArrayT<ColumnUInt64> column;
+        Timer timer;
+        column.AppendRows(offsets, values);
+        std::cerr << "AppendRows:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+}
+
+TEST(ColumnGeoPerformanceTest, AppendFlat) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ROWS_COUNT = 100'000;
+    const size_t RINGS_PER_ROW = 2;
+    const size_t POINTS_PER_RING = 16;
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<uint64_t> row_offsets;
+    std::vector<uint64_t> ring_offsets;
+    for (size_t row = 0; row < ROWS_COUNT; ++row) {
+        for (size_t ring = 0; ring < RINGS_PER_ROW; ++ring) {
+            for (size_t i = 0; i < POINTS_PER_RING; ++i) {
+                x.push_back(static_cast<double>(row + i));
+                y.push_back(static_cast<double>(ring * i));
+            }
+            ring_offsets.push_back(x.size());
+        }
+        row_offsets.push_back(ring_offsets.size());
+    }
+
+    size_t rings_count = 0;
+    {
+        ColumnPolygon column;
+        Timer timer;
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            std::vector<std::vector<ColumnPoint::ValueType>> polygon(RINGS_PER_ROW);
+            for (size_t ring = 0; ring < RINGS_PER_ROW; ++ring) {
+                const size_t begin = (row * RINGS_PER_ROW + ring) * POINTS_PER_RING;
+                for (size_t i = 0; i < POINTS_PER_RING; ++i) {
+                    polygon[ring].emplace_back(x[begin + i], y[begin + i]);
+                }
+            }
+            column.Append(polygon);
+        }
+        std::cerr << "Append:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+
+        timer.Restart();
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            for (const auto & ring : column.At(row)) {
+                rings_count += ring.size() > 0;
+            }
+        }
+        std::cerr << "At:\t" << timer.Elapsed() << std::endl;
+    }
+
+    {
+        ColumnPolygon column;
+        Timer timer;
+        column.AppendFlat(x, y, {row_offsets, ring_offsets});
+        std::cerr << "AppendFlat:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+
+        timer.Restart();
+        size_t count = 0;
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            const auto [first, last] = column.GetRowRings(row);
+            for (size_t ring = first; ring < last; ++ring) {
+                count += column.GetRing(ring).size() > 0;
+            }
+        }
+        std::cerr << "GetRing:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(rings_count, count);
+    }
+}
+
+TEST(ColumnMapPerformanceTest, AppendAndFind) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+    using LabelsColumn = ColumnMapT<ColumnString, ColumnString>;
+
+    const size_t ROWS_COUNT = 100'000;
+    const size_t LABELS_PER_ROW = 40;
+
+    std::vector<std::string> names;
+    std::vector<std::string> labels;
+    for (size_t i = 0; i < LABELS_PER_ROW; ++i) {
+        names.push_back("label_name_" + std::to_string(i));
+        labels.push_back("label_value_" + std::to_string(i));
+    }
+    const std::vector<std::string_view> keys(names.begin(), names.end());
+    const std::vector<std::string_view> values(labels.begin(), labels.end());
+
+    {
+        LabelsColumn column(std::make_shared<ColumnString>(), std::make_shared<ColumnString>());
+        Timer timer;
+        for (size_t row = 0; row < ROWS_COUNT; ++row) {
+            std::map<std::string_view, std::string_view> map;
+            for (size_t i = 0; i < LABELS_PER_ROW; ++i) {
+                map.emplace(keys[i], values[i]);
+            }
+            column.Append(map);
+        }
+        std::cerr << "Append(std::map):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+
+    LabelsColumn column(std::make_shared<ColumnString>(), std::make_shared<ColumnString>());
+    Timer timer;
+    for (size_t row = 0; row < ROWS_COUNT; ++row) {
+        column.AppendRow(keys, values);
+    }
+    std::cerr << "AppendRow:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(ROWS_COUNT, column.Size());
+
+    size_t found = 0;
+    timer.Restart();
+    for (size_t row = 0; row < ROWS_COUNT; ++row) {
+        const auto map = column.At(row);
+        for (size_t i = 0; i < LABELS_PER_ROW; i += 4) {
+            found += map.Find(keys[i]) != map.end();
+        }
+    }
+    std::cerr << "MapValueView::Find:\t" << timer.Elapsed() << std::endl;
+
+    timer.Restart();
+    for (size_t row = 0; row < ROWS_COUNT; ++row) {
+        const auto row_keys = column.RowKeys(row);
+        for (size_t i = 0; i < LABELS_PER_ROW; i += 4) {
+            for (size_t k = 0; k < row_keys.size(); ++k) {
+                if (row_keys[k] == keys[i]) {
+                    --found;
+                    break;
+                }
+            }
+        }
+    }
+    std::cerr << "RowKeys scan:\t" << timer.Elapsed() << std::endl;
+
+    timer.Restart();
+    for (size_t row = 0; row < ROWS_COUNT; ++row) {
+        const auto index = column.IndexRow(row);
+        for (size_t i = 0; i < LABELS_PER_ROW; i += 4) {
+            found += index.Contains(keys[i]);
+        }
+    }
+    std::cerr << "IndexRow:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(ROWS_COUNT * LABELS_PER_ROW / 4, found);
+}
+
+TEST(ColumnTuplePerformanceTest, AppendRows) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+    using WideTuple = ColumnTupleT<ColumnUInt64, ColumnFloat64, ColumnFloat64, ColumnFloat64,
+                                   ColumnFloat64, ColumnInt32, ColumnInt32, ColumnString>;
+
+    const size_t ROWS_COUNT = 1'000'000;
+
+    std::vector<uint64_t> ids(ROWS_COUNT);
+    std::vector<double> doubles(ROWS_COUNT);
+    std::vector<int32_t> ints(ROWS_COUNT);
+    std::vector<std::string> strings(ROWS_COUNT);
+    for (size_t i = 0; i < ROWS_COUNT; ++i) {
+        ids[i] = i;
+        doubles[i] = static_cast<double>(i) / 3;
+        ints[i] = static_cast<int32_t>(i % 1000);
+        strings[i] = "value_" + std::to_string(i % 1000);
+    }
+    const std::vector<std::string_view> views(strings.begin(), strings.end());
+
+    const auto make_column = [] {
+        return WideTuple(std::make_tuple(
+            std::make_shared<ColumnUInt64>(), std::make_shared<ColumnFloat64>(), std::make_shared<ColumnFloat64>(),
+            std::make_shared<ColumnFloat64>(), std::make_shared<ColumnFloat64>(), std::make_shared<ColumnInt32>(),
+            std::make_shared<ColumnInt32>(), std::make_shared<ColumnString>()));
+    };
+
+    {
+        auto column = make_column();
+        Timer timer;
+        for (size_t i = 0; i < ROWS_COUNT; ++i) {
+            column.Append(std::make_tuple(ids[i], doubles[i], doubles[i], doubles[i], doubles[i], ints[i], ints[i], views[i]));
+        }
+        std::cerr << "Append(tuple):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+
+    const ParallelExecutor executor = [] (size_t count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; ++i) {
+            threads.emplace_back(task, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    for (size_t workers : {1, 4}) {
+        auto column = make_column();
+        Timer timer;
+        column.AppendRows({ids, doubles, doubles, doubles, doubles, ints, ints, views}, executor, workers);
+        std::cerr << "AppendRows, " << workers << " workers:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ROWS_COUNT, column.Size());
+    }
+}
+
+TEST(ColumnDecimalPerformanceTest, AppendDoubles) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    std::vector<double> prices(ITEMS_COUNT);
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        prices[i] = static_cast<double>(i % 100'000) * 0.25 + 0.01;
+    }
+
+    {
+        std::vector<std::string> strings;
+        for (const auto price : prices) {
+            strings.push_back(std::to_string(price));
+        }
+
+        ColumnDecimal column(18, 4);
+        Timer timer;
+        for (const auto & value : strings) {
+            column.Append(value);
+        }
+        std::cerr << "Append(string):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ITEMS_COUNT, column.Size());
+    }
+
+    {
+        ColumnDecimal column(18, 4);
+        Timer timer;
+        for (const auto price : prices) {
+            column.Append(Int256(static_cast<int64_t>(std::llround(price * 10000))));
+        }
+        std::cerr << "Append(Int256):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ITEMS_COUNT, column.Size());
+    }
+
+    for (const size_t precision : {9, 18}) {
+        ColumnDecimal column(precision, 4);
+        Timer timer;
+        column.AppendDoubles(prices);
+        std::cerr << "AppendDoubles(Decimal" << (precision == 9 ? 32 : 64) << "):\t" << timer.Elapsed() << std::endl;
+
+        std::vector<double> result(column.Size());
+        timer.Restart();
+        column.ToDoubles(result);
+        std::cerr << "ToDoubles(Decimal" << (precision == 9 ? 32 : 64) << "):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(prices[1], result[1]);
+    }
+}
+
+TEST(ColumnDateTimePerformanceTest, ToCivilTimes) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    ColumnDateTime column("Europe/Berlin");
+    try {
+        TimeZone::Get(column.Timezone());
+    } catch (const ValidationError&) {
+        GTEST_SKIP() << "tz database is not available";
+    }
+    // A sequence of events, a few seconds apart, spanning several DST transitions.
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        column.AppendRaw(static_cast<uint32_t>(1'700'000'000 + i * 97));
+    }
+
+#ifndef _WIN32
+    {
+        const char* tz = std::getenv("TZ");
+        const std::string saved_tz = tz ? tz : "";
+        setenv("TZ", column.Timezone().c_str(), 1);
+        tzset();
+
+        Timer timer;
+        size_t total_hours = 0;
+        for (const auto value : column.GetRawData()) {
+            const std::time_t time = value;
+            std::tm tm{};
+            localtime_r(&time, &tm);
+            total_hours += static_cast<size_t>(tm.tm_hour);
+        }
+        std::cerr << "localtime_r:\t" << timer.Elapsed() << std::endl;
+        EXPECT_NE(0u, total_hours);
+
+        if (tz) {
+            setenv("TZ", saved_tz.c_str(), 1);
+        } else {
+            unsetenv("TZ");
+        }
+        tzset();
+    }
+#endif
+
+    std::vector<CivilTime> civil(column.Size());
+    Timer timer;
+    column.ToCivilTimes(civil);
+    std::cerr << "ToCivilTimes:\t" << timer.Elapsed() << std::endl;
+
+    ColumnDateTime copy(column.Timezone());
+    timer.Restart();
+    copy.AppendCivilTimes(civil);
+    std::cerr << "AppendCivilTimes:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(column.GetRawData()[1], copy.GetRawData()[1]);
+}
+
+TEST(ColumnUUIDPerformanceTest, Strings) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    ColumnUUID source;
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        source.Append(UUID({generate(ColumnUInt64(), i) * 31, generate(ColumnUInt64(), i * 7)}));
+    }
+
+    {
+        // Via snprintf and std::string, as applications had to do it.
+        Timer timer;
+        size_t total_size = 0;
+        for (size_t i = 0; i < source.Size(); ++i) {
+            total_size += ToString(source.At(i)).size();
+        }
+        std::cerr << "ToString:\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ITEMS_COUNT * 36, total_size);
+    }
+
+    ColumnString strings;
+    Timer timer;
+    source.ToStrings(strings);
+    std::cerr << "ToStrings:\t" << timer.Elapsed() << std::endl;
+
+    std::vector<std::string_view> texts(strings.Size());
+    for (size_t i = 0; i < strings.Size(); ++i) {
+        texts[i] = strings.At(i);
+    }
+
+    ColumnUUID column;
+    timer.Restart();
+    column.AppendStrings(texts);
+    std::cerr << "AppendStrings:\t" << timer.Elapsed() << std::endl;
+    ASSERT_EQ(ITEMS_COUNT, column.Size());
+    EXPECT_EQ(source.At(ITEMS_COUNT - 1), column.At(ITEMS_COUNT - 1));
+}
+
+TEST(ColumnIPv6PerformanceTest, Strings) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    std::vector<std::string> texts;
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        const auto value = generate(ColumnUInt64(), i);
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "2001:db8:%x::%x:%x", unsigned(i % 0xffff), unsigned(value & 0xffff), unsigned(value >> 16 & 0xfff));
+        texts.push_back(buffer);
+    }
+    const std::vector<std::string_view> views(texts.begin(), texts.end());
+
+    {
+        // With inet_pton, as Append(std::string_view) used to do it.
+        std::string data;
+        Timer timer;
+        for (const auto & text : texts) {
+            in6_addr address;
+            ASSERT_EQ(1, inet_pton(AF_INET6, text.c_str(), &address));
+            data.append(reinterpret_cast<const char*>(&address), sizeof(address));
+        }
+        std::cerr << "inet_pton:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ColumnIPv6 column;
+    Timer timer;
+    column.AppendStrings(views);
+    std::cerr << "AppendStrings:\t" << timer.Elapsed() << std::endl;
+    ASSERT_EQ(ITEMS_COUNT, column.Size());
+
+    {
+        Timer timer;
+        size_t total_size = 0;
+        for (size_t i = 0; i < column.Size(); ++i) {
+            const auto address = column.At(i);
+            char buffer[INET6_ADDRSTRLEN];
+            total_size += std::strlen(inet_ntop(AF_INET6, &address, buffer, sizeof(buffer)));
+        }
+        std::cerr << "inet_ntop:\t" << timer.Elapsed() << std::endl;
+        EXPECT_NE(0u, total_size);
+    }
+
+    ColumnString strings;
+    timer.Restart();
+    column.ToStrings(strings);
+    std::cerr << "ToStrings:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(texts[1], strings.At(1));
+}
+
+TEST(ColumnEnumPerformanceTest, AppendNames) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    std::vector<Type::EnumItem> items;
+    for (int16_t i = 0; i < 100; ++i) {
+        items.emplace_back("status_" + std::to_string(i * 7919), i);
+    }
+    const auto type = Type::CreateEnum8(items);
+
+    ColumnString names;
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        names.Append(items[i * 31 % items.size()].first);
+    }
+
+    {
+        // By std::string, as Append() used to take it.
+        ColumnEnum8 column(type);
+        Timer timer;
+        for (size_t i = 0; i < names.Size(); ++i) {
+            column.Append(std::string(names.At(i)));
+        }
+        std::cerr << "Append(std::string):\t" << timer.Elapsed() << std::endl;
+        EXPECT_EQ(ITEMS_COUNT, column.Size());
+    }
+
+    ColumnEnum8 column(type);
+    Timer timer;
+    column.AppendNames(names);
+    std::cerr << "AppendNames:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(ITEMS_COUNT, column.Size());
+
+    ColumnString result;
+    timer.Restart();
+    column.ToNames(result);
+    std::cerr << "ToNames:\t" << timer.Elapsed() << std::endl;
+    EXPECT_EQ(names.At(1), result.At(1));
+}
+
+TEST(WideIntegerPerformanceTest, UInt256ToStringAndBack) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    ColumnUInt256 column;
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        column.Append(generate(column, i));
+    }
+
+    {
+        // Digit by digit, as wide::to_string used to do it, on a thousandth of the values.
+        Timer timer;
+        size_t total_size = 0;
+        for (size_t i = 0; i < ITEMS_COUNT / 1000; ++i) {
+            UInt256 value = column[i];
+            std::string result;
+            while (value != 0) {
+                result.insert(result.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+                value /= 10;
+            }
+            total_size += result.size();
+        }
+        std::cerr << "digit by digit to_string (1/1000 of items):\t" << timer.Elapsed() << std::endl;
+        EXPECT_GT(total_size, 0u);
+    }
+
+    std::vector<std::string> strings;
+    strings.reserve(ITEMS_COUNT);
+    {
+        Timer timer;
+        for (const auto & value : column.GetData()) {
+            strings.push_back(wide::to_string(value));
+        }
+        std::cerr << "to_string:\t" << timer.Elapsed() << std::endl;
+    }
+
+    {
+        ColumnUInt256 parsed;
+        parsed.Reserve(ITEMS_COUNT);
+        Timer timer;
+        UInt256 value;
+        for (const auto & str : strings) {
+            wide::from_string(str, value);
+            parsed.Append(value);
+        }
+        std::cerr << "from_string:\t" << timer.Elapsed() << std::endl;
+        ASSERT_EQ(ITEMS_COUNT, parsed.Size());
+        EXPECT_EQ(column[ITEMS_COUNT - 1], parsed[ITEMS_COUNT - 1]);
+    }
+}
+
+TEST(WireFormatPerformanceTest, BufferedStreams) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    // Roughly what packet headers, BlockInfo and column prefixes consist of: lots of tiny fields.
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    std::cerr << "\n===========================================================" << std::endl;
+    std::cerr << "\t" << ITEMS_COUNT << " x (varint, uint8, int32, uint64) via Buffered streams" << std::endl;
+
+    Buffer buffer;
+    {
+        Timer timer;
+        BufferedOutput output(std::make_unique<BufferOutput>(&buffer));
+        for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+            WireFormat::WriteVarint64(output, i);
+            WireFormat::WriteFixed(output, static_cast<uint8_t>(i));
+            WireFormat::WriteFixed(output, static_cast<int32_t>(i));
+            WireFormat::WriteFixed(output, static_cast<uint64_t>(i));
+        }
+        output.Flush();
+
+        std::cerr << "Writing:\t" << timer.Elapsed() << std::endl;
+    }
+
+    {
+        Timer timer;
+        BufferedInput input(std::make_unique<ArrayInput>(buffer.data(), buffer.size()));
+        uint64_t varint = 0;
+        uint8_t u8 = 0;
+        int32_t i32 = 0;
+        uint64_t u64 = 0;
+        for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+            ASSERT_TRUE(WireFormat::ReadVarint64(input, &varint));
+            ASSERT_TRUE(WireFormat::ReadFixed(input, &u8));
+            ASSERT_TRUE(WireFormat::ReadFixed(input, &i32));
+            ASSERT_TRUE(WireFormat::ReadFixed(input, &u64));
+            ASSERT_EQ(varint, i);
+            ASSERT_EQ(u64, i);
+        }
+
+        std::cerr << "Reading:\t" << timer.Elapsed() << std::endl;
+    }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(ColumnPerformanceTest,
     SaveAndLoad, InsertAndSelect);
 
-using SimpleColumnTypes = testing::Types<ColumnUInt64, ColumnString, ColumnFixedString>;
+using SimpleColumnTypes = testing::Types<ColumnUInt64, ColumnUInt256, ColumnString, ColumnFixedString>;
 INSTANTIATE_TYPED_TEST_SUITE_P(SimpleColumns, ColumnPerformanceTest, SimpleColumnTypes);
 
 using LowCardinalityColumnTypes = ::testing::Types<ColumnLowCardinalityT<ColumnString>, ColumnLowCardinalityT<ColumnFixedString>>;
@@ -1,9 +1,12 @@
+#include <timeplus/base/compressed.h>
 #include <timeplus/base/wire_format.h>
 #include <timeplus/base/output.h>
 #include <timeplus/base/input.h>
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 using namespace timeplus;
 
 TEST(CodedStreamCase, Varint64) {
@@ -22,3 +25,110 @@ TEST(CodedStreamCase, Varint64) {
         ASSERT_EQ(value, 18446744071965638648ULL);
     }
 }
+
+TEST(CodedStreamCase, DecodeVarint64FromMemory) {
+    const uint64_t values[] = {0, 1, 127, 128, 300, 16384, 0xFFFFFFFFULL, 18446744071965638648ULL, UINT64_MAX};
+
+    for (const auto expected : values) {
+        // Padded memory takes the wide path, exact-size memory the byte-by-byte one.
+        uint8_t buf[32] = {0};
+        const size_t size = WireFormat::EncodeVarint64(expected, buf);
+
+        for (const size_t avail : {sizeof(buf), size}) {
+            uint64_t value = 0;
+            ASSERT_EQ(size, WireFormat::DecodeVarint64(buf, avail, &value)) << expected;
+            ASSERT_EQ(expected, value);
+        }
+
+        // Truncated value is not decoded.
+        uint64_t value = 0;
+        ASSERT_EQ(0u, WireFormat::DecodeVarint64(buf, size - 1, &value)) << expected;
+    }
+
+    // More than 10 bytes with continuation bit set is malformed.
+    uint8_t malformed[16];
+    memset(malformed, 0xFF, sizeof(malformed));
+    uint64_t value = 0;
+    ASSERT_EQ(0u, WireFormat::DecodeVarint64(malformed, sizeof(malformed), &value));
+    ASSERT_EQ(0u, WireFormat::DecodeVarint64(malformed, 11, &value));
+}
+
+TEST(CodedStreamCase, BufferedStreamsAcrossBoundaries) {
+    // Tiny buffers, so that most of the values are split between buffer refills/flushes.
+    Buffer buf;
+    {
+        BufferedOutput output(std::make_unique<BufferOutput>(&buf), 7);
+        for (uint64_t i = 0; i < 1000; ++i) {
+            WireFormat::WriteVarint64(output, i * 1000);
+            WireFormat::WriteFixed(output, i);
+            WireFormat::WriteString(output, std::string(i % 20, 'x'));
+        }
+        output.Flush();
+    }
+
+    BufferedInput input(std::make_unique<ArrayInput>(buf.data(), buf.size()), 5);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        uint64_t varint = 0;
+        uint64_t fixed = 0;
+        std::string str;
+        ASSERT_TRUE(WireFormat::ReadVarint64(input, &varint));
+        ASSERT_TRUE(WireFormat::ReadFixed(input, &fixed));
+        ASSERT_TRUE(WireFormat::ReadString(input, &str));
+        ASSERT_EQ(varint, i * 1000);
+        ASSERT_EQ(fixed, i);
+        ASSERT_EQ(str, std::string(i % 20, 'x'));
+    }
+
+    uint8_t byte = 0;
+    ASSERT_FALSE(WireFormat::ReadFixed(input, &byte));
+}
+
+TEST(CodedStreamCase, UnbufferedStreamsEmptyReadWrite) {
+    // Streams without buffer, so the fast path sees null buffer pointers.
+    struct UnbufferedInput : InputStream {
+        size_t calls = 0;
+        bool Skip(size_t) override { return true; }
+        size_t DoRead(void*, size_t len) override { ++calls; return len; }
+    };
+    struct UnbufferedOutput : OutputStream {
+        size_t calls = 0;
+        size_t DoWrite(const void*, size_t len) override { ++calls; return len; }
+    };
+
+    UnbufferedInput input;
+    UnbufferedOutput output;
+    std::string empty;
+    EXPECT_EQ(0u, input.Read(empty.data(), 0));
+    EXPECT_EQ(0u, output.Write(empty.data(), 0));
+    EXPECT_EQ(0u, input.calls);
+    EXPECT_EQ(0u, output.calls);
+
+    char byte = 0;
+    EXPECT_EQ(1u, input.Read(&byte, 1));
+    EXPECT_EQ(1u, output.Write(&byte, 1));
+}
+
+TEST(CompressedStreamCase, ZstdMultipleChunksRoundtrip) {
+    // Payload spans several chunks, so compression and decompression contexts get reused between frames.
+    Buffer payload(100000);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<uint8_t>((i / 7) % 31);
+    }
+
+    Buffer compressed;
+    {
+        BufferOutput destination(&compressed);
+        CompressedOutput output(&destination, 4096, CompressionMethod::ZSTD, 3);
+        output.Write(payload.data(), payload.size());
+        output.Flush();
+    }
+    ASSERT_LT(compressed.size(), payload.size());
+
+    Buffer decompressed(payload.size());
+    {
+        ArrayInput source(compressed.data(), compressed.size());
+        CompressedInput input(&source);
+        ASSERT_TRUE(WireFormat::ReadBytes(input, decompressed.data(), decompressed.size()));
+    }
+    EXPECT_EQ(payload, decompressed);
+}
@@ -67,6 +67,47 @@ TEST(TypesCase, EnumTypes) {
     ASSERT_EQ((++enum16->As<EnumType>()->BeginValueToName())->second, "Red");
 }
 
+TEST(TypesCase, EnumTypesLookup) {
+    // Full range of Enum8 values, sparse Enum16 values (not covered by dense lookup table).
+    auto enum8 = Type::CreateEnum8({{"min", -128}, {"zero", 0}, {"", 5}, {"max", 127}});
+    auto enum16 = Type::CreateEnum16({{"min", -32768}, {"zero", 0}, {"max", 32767}});
+
+    for (const auto & type : {enum8, enum16}) {
+        const auto enum_type = type->As<EnumType>();
+        SCOPED_TRACE(type->GetName());
+
+        EXPECT_EQ("zero", enum_type->GetEnumName(0));
+        EXPECT_EQ("max", enum_type->GetEnumName(enum_type->GetEnumValue("max")));
+        EXPECT_EQ("min", enum_type->GetEnumName(enum_type->GetEnumValue("min")));
+        EXPECT_FALSE(enum_type->HasEnumValue(1));
+        EXPECT_FALSE(enum_type->HasEnumValue(-1));
+        EXPECT_EQ(nullptr, enum_type->FindEnumName(100));
+        EXPECT_THROW(enum_type->GetEnumName(1), std::out_of_range);
+
+        int16_t value = 42;
+        EXPECT_TRUE(enum_type->FindEnumValue(std::string_view("zero_", 4), value));
+        EXPECT_EQ(0, value);
+        EXPECT_FALSE(enum_type->FindEnumValue("Zero", value));
+        EXPECT_THROW(enum_type->GetEnumValue("Zero"), std::out_of_range);
+    }
+
+    EXPECT_EQ("", enum8->As<EnumType>()->GetEnumName(5));
+    EXPECT_TRUE(enum8->As<EnumType>()->HasEnumName(""));
+    EXPECT_FALSE(enum16->As<EnumType>()->HasEnumName(""));
+    EXPECT_FALSE(enum16->As<EnumType>()->HasEnumValue(-32767));
+
+    std::vector<Type::EnumItem> items;
+    for (int16_t i = -1000; i < 1000; ++i) {
+        items.emplace_back("item" + std::to_string(i), static_cast<int16_t>(i * 3));
+    }
+    const auto large = Type::CreateEnum16(items);
+    for (const auto & [name, value] : items) {
+        ASSERT_EQ(name, large->As<EnumType>()->GetEnumName(value));
+        ASSERT_EQ(value, large->As<EnumType>()->GetEnumValue(name));
+        ASSERT_FALSE(large->As<EnumType>()->HasEnumValue(static_cast<int16_t>(value + 1)));
+    }
+}
+
 TEST(TypesCase, EnumTypesEmpty) {
     ASSERT_EQ("enum8()", Type::CreateEnum8({})->GetName());
     ASSERT_EQ("enum16()", Type::CreateEnum16({})->GetName());
@@ -2,12 +2,19 @@
 #include "ut/value_generators.h"
 #include "utils.h"
 #include <timeplus/block.h>
+#include <timeplus/base/flat_hash_map.h>
+#include <timeplus/base/hex.h>
+#include <timeplus/base/time_zone.h>
 #include <timeplus/columns/numeric.h>
 
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
 #include <numeric>
 #include <limits>
 #include <optional>
+#include <random>
+#include <unordered_map>
 #include <vector>
 using namespace timeplus;
 
@@ -59,6 +66,308 @@ TEST(StringUtils, UUID) {
     EXPECT_EQ(ToString(uuid), uuid_string);
 }
 
+TEST(Hex, EncodeDecode) {
+    std::vector<uint8_t> bytes(100);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    // Sizes around SIMD block boundaries.
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        std::string hex(size * 2, '\0');
+        EncodeHex(bytes.data(), size, hex.data());
+        for (size_t i = 0; i < size; ++i) {
+            char expected[3];
+            std::snprintf(expected, sizeof(expected), "%02x", bytes[i]);
+            ASSERT_EQ(std::string_view(expected, 2), std::string_view(hex).substr(i * 2, 2)) << size << " " << i;
+        }
+
+        std::vector<uint8_t> decoded(size);
+        ASSERT_TRUE(DecodeHex(hex.data(), size, decoded.data())) << size;
+        EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), bytes.begin())) << size;
+    }
+
+    uint8_t decoded[20];
+    EXPECT_TRUE(DecodeHex("0123456789ABCDEFabcdef0123456789aBcDeF00", 20, decoded));
+    EXPECT_EQ(0xab, decoded[5]);
+    EXPECT_EQ(0xcd, decoded[6]);
+
+    // Any non-hex character is detected, wherever it is.
+    const std::string valid(40, 'a');
+    for (size_t pos = 0; pos < valid.size(); ++pos) {
+        for (const char c : {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xb0', '\xe1', '\xff'}) {
+            auto invalid = valid;
+            invalid[pos] = c;
+            ASSERT_FALSE(DecodeHex(invalid.data(), 20, decoded)) << pos << " " << int(c);
+        }
+    }
+}
+
+namespace {
+// Deliberately poor hash: lots of items share position and control byte.
+struct CollidingHash {
+    size_t operator()(uint64_t key) const { return key % 37 * 1000; }
+};
+}
+
+TEST(WideInteger, ToString) {
+    EXPECT_EQ("0", wide::to_string(UInt256(0)));
+    EXPECT_EQ("-1", wide::to_string(Int128(-1)));
+    EXPECT_EQ("9999999999999999999", wide::to_string(UInt128(9999999999999999999ULL)));
+    EXPECT_EQ("10000000000000000000", wide::to_string(UInt128(10000000000000000000ULL)));
+    EXPECT_EQ("100000000000000000000000000000000000001", wide::to_string(UInt128(10000000000000000000ULL) * UInt128(10000000000000000000ULL) + 1));
+    EXPECT_EQ("-170141183460469231731687303715884105728", wide::to_string(std::numeric_limits<Int128>::min()));
+    EXPECT_EQ("340282366920938463463374607431768211455", wide::to_string(std::numeric_limits<UInt128>::max()));
+    EXPECT_EQ("-57896044618658097711785492504343953926634992332820282019728792003956564819968", wide::to_string(std::numeric_limits<Int256>::min()));
+    EXPECT_EQ("115792089237316195423570985008687907853269984665640564039457584007913129639935", wide::to_string(std::numeric_limits<UInt256>::max()));
+
+    // Matches digit by digit conversion.
+    std::mt19937_64 random(42);
+    for (size_t i = 0; i < 200; ++i) {
+        Int256 value;
+        for (auto & item : value.items) {
+            item = random() >> (random() % 64);
+        }
+
+        std::string expected;
+        Int256 rest = value < 0 ? -value : value;
+        do {
+            expected.insert(expected.begin(), static_cast<char>('0' + static_cast<int>(rest % 10)));
+            rest /= 10;
+        } while (rest != 0);
+        if (value < 0) {
+            expected.insert(expected.begin(), '-');
+        }
+
+        ASSERT_EQ(expected, wide::to_string(value));
+    }
+}
+
+TEST(WideInteger, FromString) {
+    std::mt19937_64 random(42);
+    for (size_t i = 0; i < 1000; ++i) {
+        Int256 value;
+        for (auto & item : value.items) {
+            item = random() >> (random() % 64);
+        }
+
+        Int256 parsed;
+        ASSERT_TRUE(wide::from_string(wide::to_string(value), parsed));
+        ASSERT_EQ(value, parsed);
+    }
+
+    Int128 value = 7;
+    EXPECT_TRUE(wide::from_string("-170141183460469231731687303715884105728", value));
+    EXPECT_EQ(std::numeric_limits<Int128>::min(), value);
+    EXPECT_TRUE(wide::from_string("000000000000000000000000000000000000000000000000012", value));
+    EXPECT_EQ(Int128(12), value);
+
+    EXPECT_FALSE(wide::from_string("170141183460469231731687303715884105728", value));
+    EXPECT_FALSE(wide::from_string("-170141183460469231731687303715884105729", value));
+    EXPECT_FALSE(wide::from_string("", value));
+    EXPECT_FALSE(wide::from_string("-", value));
+    EXPECT_FALSE(wide::from_string("12a", value));
+    EXPECT_FALSE(wide::from_string("+1", value));
+    EXPECT_EQ(Int128(12), value);
+
+    UInt256 unsigned_value;
+    EXPECT_TRUE(wide::from_string("115792089237316195423570985008687907853269984665640564039457584007913129639935", unsigned_value));
+    EXPECT_EQ(std::numeric_limits<UInt256>::max(), unsigned_value);
+    EXPECT_FALSE(wide::from_string("115792089237316195423570985008687907853269984665640564039457584007913129639936", unsigned_value));
+    EXPECT_FALSE(wide::from_string("-1", unsigned_value));
+}
+
+TEST(WideInteger, Int128AddSubtract) {
+    EXPECT_EQ(UInt128(1) << 64, UInt128(std::numeric_limits<uint64_t>::max()) + 1);
+    EXPECT_EQ(UInt128(std::numeric_limits<uint64_t>::max()), (UInt128(1) << 64) - 1);
+    EXPECT_EQ(Int128(-1), Int128(0) - 1);
+    EXPECT_EQ(Int128(-5), Int128(3) + Int128(-8));
+    EXPECT_EQ(std::numeric_limits<Int128>::min(), std::numeric_limits<Int128>::max() + 1);
+    EXPECT_EQ(Int128(1) << 100, (Int128(1) << 100) - Int128(-1) - 1);
+}
+
+namespace {
+
+std::shared_ptr<const TimeZone> GetTimeZoneOrNull(const std::string& name) {
+    try {
+        return TimeZone::Get(name);
+    } catch (const ValidationError&) {
+        return nullptr;
+    }
+}
+
+CivilTime MakeCivilTime(int32_t year, int month, int day, int hour, int minute, int second) {
+    CivilTime result;
+    result.year = year;
+    result.month = static_cast<uint8_t>(month);
+    result.day = static_cast<uint8_t>(day);
+    result.hour = static_cast<uint8_t>(hour);
+    result.minute = static_cast<uint8_t>(minute);
+    result.second = static_cast<uint8_t>(second);
+    return result;
+}
+
+}
+
+TEST(TimeZone, UTC) {
+    const auto utc = TimeZone::Get("");
+    EXPECT_EQ(utc, TimeZone::Get(""));
+
+    EXPECT_EQ(MakeCivilTime(1970, 1, 1, 0, 0, 0), utc->ToCivil(0));
+    EXPECT_EQ(MakeCivilTime(1969, 12, 31, 23, 59, 59), utc->ToCivil(-1));
+    EXPECT_EQ(MakeCivilTime(2000, 2, 29, 12, 30, 15), utc->ToCivil(951827415));
+    EXPECT_EQ(MakeCivilTime(1900, 1, 1, 0, 0, 0), utc->ToCivil(-2208988800));
+    EXPECT_EQ(MakeCivilTime(2299, 12, 31, 23, 59, 59), utc->ToCivil(10413791999));
+
+    EXPECT_EQ(951827415, utc->FromCivil(MakeCivilTime(2000, 2, 29, 12, 30, 15)));
+    // Normalized as with timegm.
+    EXPECT_EQ(utc->FromCivil(MakeCivilTime(2001, 3, 1, 0, 0, 0)), utc->FromCivil(MakeCivilTime(2001, 2, 29, 0, 0, 0)));
+    EXPECT_THROW(utc->FromCivil(MakeCivilTime(2001, 13, 1, 0, 0, 0)), ValidationError);
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int64_t> times(-2208988800, 10413791999);
+    std::vector<int64_t> values(1000);
+    for (auto & value : values) {
+        value = times(random);
+    }
+    std::vector<CivilTime> civil(values.size());
+    std::vector<int64_t> back(values.size());
+    utc->ToCivil(values.data(), values.size(), civil.data());
+    utc->FromCivil(civil.data(), civil.size(), back.data());
+    EXPECT_EQ(values, back);
+
+#ifndef _WIN32
+    for (size_t i = 0; i < values.size(); ++i) {
+        const std::time_t time = static_cast<std::time_t>(values[i]);
+        std::tm tm{};
+        gmtime_r(&time, &tm);
+        ASSERT_EQ(MakeCivilTime(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec), civil[i]) << values[i];
+    }
+#endif
+}
+
+TEST(TimeZone, Transitions) {
+    const auto berlin = GetTimeZoneOrNull("Europe/Berlin");
+    const auto sydney = GetTimeZoneOrNull("Australia/Sydney");
+    if (!berlin || !sydney) {
+        GTEST_SKIP() << "tz database is not available";
+    }
+
+    // Clocks turned forward at 01:00 UTC.
+    EXPECT_EQ(MakeCivilTime(2024, 3, 31, 1, 59, 59), berlin->ToCivil(1711846799));
+    EXPECT_EQ(MakeCivilTime(2024, 3, 31, 3, 0, 0), berlin->ToCivil(1711846800));
+    EXPECT_EQ(7200, berlin->UtcOffset(1711846800));
+    // Skipped time is shifted forward.
+    EXPECT_EQ(1711848600, berlin->FromCivil(MakeCivilTime(2024, 3, 31, 2, 30, 0)));
+
+    // Clocks turned back at 01:00 UTC.
+    EXPECT_EQ(MakeCivilTime(2024, 10, 27, 2, 59, 59), berlin->ToCivil(1729990799));
+    EXPECT_EQ(MakeCivilTime(2024, 10, 27, 2, 0, 0), berlin->ToCivil(1729990800));
+    // Repeated time is taken at its first occurrence.
+    EXPECT_EQ(1729989000, berlin->FromCivil(MakeCivilTime(2024, 10, 27, 2, 30, 0)));
+
+    // Far beyond transitions listed in tz database.
+    EXPECT_EQ(MakeCivilTime(2250, 7, 1, 14, 0, 0), berlin->ToCivil(berlin->FromCivil(MakeCivilTime(2250, 7, 1, 14, 0, 0))));
+    EXPECT_EQ(7200, berlin->UtcOffset(TimeZone::Get("")->FromCivil(MakeCivilTime(2250, 7, 1, 12, 0, 0))));
+    EXPECT_EQ(3600, berlin->UtcOffset(TimeZone::Get("")->FromCivil(MakeCivilTime(2250, 12, 1, 12, 0, 0))));
+
+    // Southern hemisphere.
+    EXPECT_EQ(MakeCivilTime(2024, 1, 15, 11, 0, 0), sydney->ToCivil(1705276800));
+    EXPECT_EQ(MakeCivilTime(2024, 7, 15, 10, 0, 0), sydney->ToCivil(1721001600));
+
+    EXPECT_THROW(TimeZone::Get("No/Such_Zone"), ValidationError);
+    EXPECT_THROW(TimeZone::Get("../etc/passwd"), ValidationError);
+}
+
+#ifndef _WIN32
+TEST(TimeZone, MatchesLibc) {
+    const char* names[] = {"Europe/Berlin", "America/New_York", "Australia/Sydney", "Asia/Kolkata"};
+
+    const char* tz = std::getenv("TZ");
+    const std::string saved_tz = tz ? tz : "";
+
+    std::mt19937_64 random(42);
+    // glibc handles 32-bit time_t boundaries of some zones differently, stay within the range it surely gets right.
+    std::uniform_int_distribution<int64_t> times(-2000000000, 8000000000);
+
+    for (const auto name : names) {
+        const auto time_zone = GetTimeZoneOrNull(name);
+        if (!time_zone) {
+            GTEST_SKIP() << "tz database is not available";
+        }
+
+        setenv("TZ", name, 1);
+        tzset();
+        for (size_t i = 0; i < 2000; ++i) {
+            const auto value = times(random);
+            const std::time_t time = static_cast<std::time_t>(value);
+            std::tm tm{};
+            localtime_r(&time, &tm);
+
+            ASSERT_EQ(MakeCivilTime(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec), time_zone->ToCivil(value))
+                << name << " " << value;
+            ASSERT_EQ(tm.tm_gmtoff, time_zone->UtcOffset(value)) << name << " " << value;
+        }
+    }
+
+    if (tz) {
+        setenv("TZ", saved_tz.c_str(), 1);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+}
+#endif
+
+TEST(FlatHashMap, MatchesUnorderedMap) {
+    FlatHashMap<uint64_t, size_t, CollidingHash> map;
+    std::unordered_map<uint64_t, size_t> expected;
+
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < 20000; ++i) {
+        const uint64_t key = rng() % 3000;
+        if (rng() % 3 == 0) {
+            auto item = map.find(key);
+            ASSERT_EQ(item != nullptr, expected.count(key) == 1) << key;
+            if (item) {
+                map.erase(item);
+                expected.erase(key);
+            }
+        } else {
+            const auto [item, inserted] = map.try_emplace(key, i);
+            const auto [expected_item, expected_inserted] = expected.try_emplace(key, i);
+            ASSERT_EQ(inserted, expected_inserted) << key;
+            ASSERT_EQ(item->second, expected_item->second) << key;
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+
+    for (const auto & [key, value] : expected) {
+        auto item = map.find(key);
+        ASSERT_NE(item, nullptr) << key;
+        EXPECT_EQ(item->second, value);
+    }
+
+    const auto capacity = map.capacity();
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(expected.begin()->first), nullptr);
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(FlatHashMap, Reserve) {
+    FlatHashMap<uint64_t, uint64_t> map;
+    map.reserve(1000);
+    const auto capacity = map.capacity();
+    EXPECT_GE(capacity, 1000u);
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        map.try_emplace(i, i * 2);
+    }
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(map.find(999)->second, 1998u);
+}
+
 TEST(CompareRecursive, Nan) {
     /// Even though NaN == NaN is FALSE, CompareRecursive must compare those as TRUE.
 